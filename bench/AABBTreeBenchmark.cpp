@@ -0,0 +1,153 @@
+/**
+ * @file AABBTreeBenchmark.cpp
+ * @brief Comparer l'arbre AABBTree à un parcours linéaire avec des boîtes en mouvement
+ * Utilisation : AABBTreeBenchmark [nombre d'objets] (10000 par défaut)
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <glm/gtc/matrix_transform.hpp>
+#include "Core/Logger.hpp"
+#include "Render3D/AABBTree.hpp"
+
+using namespace Render3D;
+
+namespace {
+
+void runAABBTreeBenchmark(std::size_t objectCount) {
+	using Clock = std::chrono::steady_clock;
+	const int frames = 60;
+	const float worldSize = 512.0f;
+
+	// Objets de 0.5 à 2 blocs, un quart immobiles, les autres avancent en ligne droite dans le monde
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> position(0.0f, worldSize);
+	std::uniform_real_distribution<float> size(0.25f, 1.0f);
+	std::uniform_real_distribution<float> speed(-4.0f, 4.0f);
+
+	struct Prop {
+		glm::vec3 center, extents, velocity;
+		int proxy;
+		AABB box() const {
+			return {center - extents, center + extents};
+		}
+	};
+	std::vector<Prop> props(objectCount);
+	// Marge d'un demi-bloc : un objet à 4 blocs/s reste ~8 images dans sa boîte grasse
+	AABBTree tree(0.5f);
+
+	auto start = Clock::now();
+	for (std::size_t i = 0; i < objectCount; ++i) {
+		Prop &prop = props[i];
+		prop.center = glm::vec3(position(random), position(random) * 0.125f, position(random));
+		prop.extents = glm::vec3(size(random));
+		prop.velocity = i % 4 == 0 ? glm::vec3(0.0f) : glm::vec3(speed(random), 0.0f, speed(random));
+		prop.proxy = tree.insert(prop.box(), &prop);
+	}
+	float insertMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+	LOG(Info) << "AABB tree benchmark: " << objectCount << " props, " << frames << " frames";
+	LOG(Info) << "Insert: " << insertMs << " ms, height " << tree.getHeight() << ", area ratio " << tree.getAreaRatio();
+
+	std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+	float treeMs[3] = {0.0f, 0.0f, 0.0f};	// déplacement, frustum, requêtes (boîtes + rayons)
+	float linearMs[3] = {0.0f, 0.0f, 0.0f};
+	std::size_t reinserted = 0, mismatches = 0;
+	std::size_t treeVisible = 0, linearVisible = 0;
+
+	for (int frame = 0; frame < frames; ++frame) {
+		const float dt = 1.0f / 60.0f;
+
+		// Déplacement (la version linéaire n'a rien à mettre à jour)
+		start = Clock::now();
+		for (auto &prop : props) {
+			if (prop.velocity == glm::vec3(0.0f)) {
+				continue;
+			}
+			prop.center += prop.velocity * dt;
+			reinserted += tree.move(prop.proxy, prop.box());
+		}
+		tree.optimize(16);
+		treeMs[0] += std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+
+		// Caméra au sol qui tourne sur elle-même
+		glm::vec3 eye(worldSize * 0.5f, 8.0f, worldSize * 0.5f);
+		float a = angle(random);
+		glm::vec3 direction(std::cos(a), -0.1f, std::sin(a));
+		Frustum frustum;
+		frustum.CalculatePlanes(glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 200.0f) *
+								glm::lookAt(eye, eye + direction, glm::vec3(0.0f, 1.0f, 0.0f)));
+
+		std::size_t visible = 0;
+		start = Clock::now();
+		tree.query(frustum, [&](void *) { visible++; });
+		treeMs[1] += std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+		treeVisible += visible;
+
+		// La boîte grasse peut être visible alors que l'objet ne l'est pas : on compare donc aux boîtes grasses
+		visible = 0;
+		start = Clock::now();
+		for (const auto &prop : props) {
+			visible += frustum.AABBIsInside(tree.getFatAABB(prop.proxy));
+		}
+		linearMs[1] += std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+		linearVisible += visible;
+
+		// 100 requêtes de voisinage et 100 rayons de sélection
+		std::size_t treeHits = 0, linearHits = 0;
+		start = Clock::now();
+		for (int q = 0; q < 100; ++q) {
+			const Prop &prop = props[(q * 7919) % objectCount];
+			AABB area = {prop.center - glm::vec3(4.0f), prop.center + glm::vec3(4.0f)};
+			tree.query(area, [&](void *) { treeHits++; });
+			float closest = 200.0f;
+			tree.raycast(eye, glm::vec3(std::cos(a + q * 0.01f), -0.05f, std::sin(a + q * 0.01f)), closest,
+						 [&](void *, float distance) { return closest = std::min(closest, distance); });
+			treeHits += closest < 200.0f;
+		}
+		treeMs[2] += std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+
+		start = Clock::now();
+		for (int q = 0; q < 100; ++q) {
+			const Prop &prop = props[(q * 7919) % objectCount];
+			AABB area = {prop.center - glm::vec3(4.0f), prop.center + glm::vec3(4.0f)};
+			glm::vec3 inverseDirection = 1.0f / glm::vec3(std::cos(a + q * 0.01f), -0.05f, std::sin(a + q * 0.01f));
+			float closest = 200.0f;
+			for (const auto &other : props) {
+				const AABB &fat = tree.getFatAABB(other.proxy);
+				linearHits += fat.overlaps(area);
+				float distance;
+				if (fat.intersectsRay(eye, inverseDirection, closest, distance)) {
+					closest = distance;
+				}
+			}
+			linearHits += closest < 200.0f;
+		}
+		linearMs[2] += std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+		mismatches += treeHits != linearHits;
+	}
+
+	LOG(Info) << "Move + optimize: " << treeMs[0] / frames << " ms / frame, " << reinserted / frames << " reinsertions / frame";
+	LOG(Info) << "Frustum: tree " << treeMs[1] / frames << " ms, linear " << linearMs[1] / frames << " ms ("
+			  << treeVisible / frames << " / " << linearVisible / frames << " visible)";
+	LOG(Info) << "100 overlaps + 100 rays: tree " << treeMs[2] / frames << " ms, linear " << linearMs[2] / frames << " ms, "
+			  << mismatches << " frames with different results";
+	LOG(Info) << "Final height " << tree.getHeight() << ", area ratio " << tree.getAreaRatio() << (tree.validate() ? "" : ", INVALID TREE");
+	tree.rebuild();
+	LOG(Info) << "After rebuild: height " << tree.getHeight() << ", area ratio " << tree.getAreaRatio() << (tree.validate() ? "" : ", INVALID TREE");
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+	LOG_TERMINAL_ENABLE();
+	std::size_t objectCount = argc > 1 ? std::stoul(argv[1]) : 10000;
+	if (objectCount == 0) {
+		LOG(Error) << "Object count must be at least 1";
+		return 1;
+	}
+	runAABBTreeBenchmark(objectCount);
+	return 0;
+}
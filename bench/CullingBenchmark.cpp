@@ -0,0 +1,103 @@
+/**
+ * @file CullingBenchmark.cpp
+ * @brief Comparer le noyau SoA de FrustumCuller au test historique des 8 coins avec Frustum::PointIsInside
+ * Utilisation : CullingBenchmark [nombre de boîtes] (100000 par défaut)
+ */
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <glm/gtc/matrix_transform.hpp>
+#include "Core/Logger.hpp"
+#include "Render3D/FrustumCuller.hpp"
+
+using namespace Render3D;
+
+namespace {
+
+void runCullingBenchmark(std::size_t boxCount) {
+	using Clock = std::chrono::steady_clock;
+	const int passes = 50;
+
+	// Boîtes de la taille d'un chunk ou d'un objet réparties autour d'une caméra regardant vers -z
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> position(-256.0f, 256.0f);
+	std::uniform_real_distribution<float> size(0.5f, 16.0f);
+
+	std::vector<AABB> boxes(boxCount);
+	FrustumCuller culler;
+	culler.reserve(boxCount);
+	for (auto &box : boxes) {
+		glm::vec3 center(position(random), position(random) * 0.25f, position(random));
+		glm::vec3 extents(size(random) * 0.5f);
+		box = {center - extents, center + extents};
+		culler.add(box);
+	}
+
+	glm::mat4 projection = glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 200.0f);
+	glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	Frustum frustum;
+	frustum.CalculatePlanes(projection * view);
+
+	auto measure = [&](const char *name, const auto &function) {
+		std::size_t visible = function();
+		auto start = Clock::now();
+		for (int pass = 0; pass < passes; ++pass) {
+			visible = function();
+		}
+		float ms = std::chrono::duration<float, std::milli>(Clock::now() - start).count() / passes;
+		LOG(Info) << name << ": " << ms << " ms / pass, " << ms * 1.0e6f / boxCount << " ns / box, "
+				  << visible << " visible";
+		return ms;
+	};
+
+	LOG(Info) << "Culling benchmark: " << boxCount << " boxes, " << passes << " passes";
+
+	// Ancienne méthode : 8 coins par boîte, visible si au moins un coin est dans le frustum
+	std::vector<glm::vec3> corners(8);
+	float pointMs = measure("PointIsInside (8 corners)", [&]() {
+		std::size_t visible = 0;
+		for (const auto &box : boxes) {
+			for (int i = 0; i < 8; ++i) {
+				corners[i] = glm::vec3(i & 1 ? box.max.x : box.min.x, i & 2 ? box.max.y : box.min.y, i & 4 ? box.max.z : box.min.z);
+			}
+			visible += frustum.LeastOnePointIsInside(corners);
+		}
+		return visible;
+	});
+
+	measure("AABBIsInside", [&]() {
+		std::size_t visible = 0;
+		for (const auto &box : boxes) {
+			visible += frustum.AABBIsInside(box);
+		}
+		return visible;
+	});
+
+	std::vector<uint64_t> reference, visibility;
+	culler.cull(frustum, reference, FrustumCuller::Path::Scalar);
+	for (auto path : {FrustumCuller::Path::Scalar, FrustumCuller::Path::SSE, FrustumCuller::Path::AVX}) {
+		if (path > FrustumCuller::getBestPath()) {
+			continue;
+		}
+		std::string name = std::string("FrustumCuller ") + FrustumCuller::getPathName(path);
+		float ms = measure(name.c_str(), [&]() {
+			return culler.cull(frustum, visibility, path);
+		});
+		LOG(Info) << "  x" << pointMs / ms << " vs PointIsInside, "
+				  << (visibility == reference ? "same result as scalar" : "DIFFERENT RESULT FROM SCALAR");
+	}
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+	LOG_TERMINAL_ENABLE();
+	std::size_t boxCount = argc > 1 ? std::stoul(argv[1]) : 100000;
+	if (boxCount == 0) {
+		LOG(Error) << "Box count must be at least 1";
+		return 1;
+	}
+	runCullingBenchmark(boxCount);
+	return 0;
+}
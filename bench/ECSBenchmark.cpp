@@ -0,0 +1,287 @@
+// ECS microbenchmark: compares the archetype storage with the former layout (one map of
+// heap-allocated components per entity), then measures change detection and entity churn
+// Usage: ECSBenchmark [entity count] (10k, 100k and 1M by default)
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Core/Logger.hpp"
+#include "ECS/Components.hpp"
+#include "ECS/Manager.hpp"
+
+// Former layout, kept here as the benchmark reference: each entity owns a map of
+// heap-allocated components, found by name and checked with dynamic_cast
+namespace {
+
+class MapStorage {
+public:
+    using EntityID = size_t;
+
+    EntityID createEntity() {
+        EntityID id = nextEntityID++;
+        entities[id] = std::unordered_map<std::string, std::unique_ptr<ComponentBase>>();
+        return id;
+    }
+
+    std::vector<EntityID> getEntitiesWithComponents(const std::vector<std::string>& componentTypes) {
+        std::vector<EntityID> matchingEntities;
+        for (const auto& [entityID, components] : entities) {
+            bool allComponentsPresent = true;
+            for (const auto& componentType : componentTypes) {
+                if (components.find(componentType) == components.end()) {
+                    allComponentsPresent = false;
+                    break;
+                }
+            }
+            if (allComponentsPresent) {
+                matchingEntities.push_back(entityID);
+            }
+        }
+        return matchingEntities;
+    }
+
+    template<typename T>
+    void addComponent(EntityID entity, const std::string& componentType, std::unique_ptr<T> component) {
+        entities[entity][componentType] = std::move(component);
+    }
+
+    template<typename T>
+    T* getComponent(EntityID entity, const std::string& componentType) {
+        auto& components = entities[entity];
+        if (components.find(componentType) != components.end()) {
+            return dynamic_cast<T*>(components[componentType].get());
+        }
+        return nullptr;
+    }
+
+private:
+    EntityID nextEntityID = 0;
+    std::unordered_map<EntityID, std::unordered_map<std::string, std::unique_ptr<ComponentBase>>> entities;
+};
+
+// Like a save system that only serializes dirty entities: visits the transforms written since its previous call
+class DirtyTransformSystem : public SystemBase {
+public:
+    size_t count = 0;
+    double checksum = 0.0;
+
+    explicit DirtyTransformSystem(std::shared_ptr<Manager> manager)
+        : SystemBase(manager, 0), view(manager->query<Changed<const TransformComponent>>()) {
+        reads<TransformComponent>();
+    }
+
+    void preUpdate(SDL_Event*, SDL_Renderer*, float) override {}
+    void update(SDL_Event*, SDL_Renderer*, float) override {
+        count = 0;
+        view.forEach([this](EntityID, const TransformComponent& transform) {
+            count++;
+            checksum += transform.position.x;
+        });
+    }
+    void postUpdate(SDL_Event*, SDL_Renderer*, float) override {}
+
+private:
+    View<Changed<const TransformComponent>> view;
+};
+
+void runECSBenchmark(size_t entityCount) {
+    using Clock = std::chrono::steady_clock;
+    const int frames = 10;
+    const float dt = 1.0f / 60.0f;
+
+    // Every entity moves, one in four also has a shape (two archetypes, like spheres and crates)
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> coordinate(-100.0f, 100.0f);
+    std::vector<glm::vec3> positions(entityCount), velocities(entityCount);
+    for (size_t i = 0; i < entityCount; ++i) {
+        positions[i] = glm::vec3(coordinate(random), coordinate(random), coordinate(random));
+        velocities[i] = glm::vec3(coordinate(random), 0.0f, coordinate(random)) * 0.01f;
+    }
+
+    // Lookups by entity (index in creation order), like the collision pairs of PhysicsSystem
+    const size_t lookupCount = 100000;
+    std::vector<size_t> lookups(lookupCount);
+    std::uniform_int_distribution<size_t> entityIndex(0, entityCount - 1);
+    for (auto& lookup : lookups) {
+        lookup = entityIndex(random);
+    }
+
+    LOG(Info) << "ECS benchmark: " << entityCount << " entities, " << frames << " frames";
+
+    float mapCreateMs, mapUpdateMs, mapLookupMs, archetypeCreateMs, archetypeUpdateMs, archetypeLookupMs, churnMs, bufferedChurnMs;
+    float fullReadMs, dirtyReadMs;
+    size_t slotsBeforeChurn, slotsAfterChurn, dirtyCount = 0;
+    double mapChecksum = 0.0, archetypeChecksum = 0.0;
+    {
+        using EntityID = MapStorage::EntityID;
+        MapStorage storage;
+        auto start = Clock::now();
+        for (size_t i = 0; i < entityCount; ++i) {
+            EntityID entity = storage.createEntity();
+            storage.addComponent(entity, "Transform", std::make_unique<TransformComponent>(positions[i]));
+            storage.addComponent(entity, "Mobile", std::make_unique<MobileComponent>(MobileComponent::DYNAMIC, velocities[i]));
+            if (i % 4 == 0) {
+                storage.addComponent(entity, "Shape", std::make_unique<ShapeComponent>(ShapeComponent::PARALLEPIPED));
+            }
+        }
+        mapCreateMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+
+        start = Clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            for (EntityID entity : storage.getEntitiesWithComponents({"Transform", "Mobile"})) {
+                TransformComponent* transform = storage.getComponent<TransformComponent>(entity, "Transform");
+                MobileComponent* mobile = storage.getComponent<MobileComponent>(entity, "Mobile");
+                transform->position += mobile->velocity * dt;
+            }
+        }
+        mapUpdateMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count() / frames;
+
+        start = Clock::now();
+        for (EntityID entity : lookups) {  // ids are given in creation order from 0
+            TransformComponent* transform = storage.getComponent<TransformComponent>(entity, "Transform");
+            MobileComponent* mobile = storage.getComponent<MobileComponent>(entity, "Mobile");
+            ShapeComponent* shape = storage.getComponent<ShapeComponent>(entity, "Shape");
+            mapChecksum += transform->position.y + mobile->mass + (shape != nullptr);
+        }
+        mapLookupMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+
+        for (EntityID entity : storage.getEntitiesWithComponents({"Transform"})) {
+            mapChecksum += storage.getComponent<TransformComponent>(entity, "Transform")->position.x;
+        }
+    }
+    {
+        auto sharedManager = std::make_shared<Manager>();
+        Manager& manager = *sharedManager;
+        std::vector<EntityID> created;
+        created.reserve(entityCount);
+        auto start = Clock::now();
+        for (size_t i = 0; i < entityCount; ++i) {
+            EntityID entity = manager.createEntity();
+            created.push_back(entity);
+            manager.add<TransformComponent>(entity, positions[i]);
+            manager.add<MobileComponent>(entity, MobileComponent::DYNAMIC, velocities[i]);
+            if (i % 4 == 0) {
+                manager.add<ShapeComponent>(entity, ShapeComponent::PARALLEPIPED);
+            }
+        }
+        archetypeCreateMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+
+        start = Clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            manager.forEach<TransformComponent, const MobileComponent>([dt](EntityID, TransformComponent& transform, const MobileComponent& mobile) {
+                transform.position += mobile.velocity * dt;
+            });
+        }
+        archetypeUpdateMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count() / frames;
+
+        start = Clock::now();
+        for (size_t lookup : lookups) {
+            EntityID entity = created[lookup];
+            const TransformComponent* transform = manager.get<const TransformComponent>(entity);
+            const MobileComponent* mobile = manager.get<const MobileComponent>(entity);
+            const ShapeComponent* shape = manager.get<const ShapeComponent>(entity);
+            archetypeChecksum += transform->position.y + mobile->mass + (shape != nullptr);
+        }
+        archetypeLookupMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+
+        start = Clock::now();
+        manager.forEach<const TransformComponent>([&](EntityID, const TransformComponent& transform) {
+            archetypeChecksum += transform.position.x;
+        });
+        fullReadMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+
+        // Every frame 1% of the transforms are written, the dirty pass only visits those
+        auto dirtySystem = std::make_unique<DirtyTransformSystem>(sharedManager);
+        DirtyTransformSystem* dirty = dirtySystem.get();
+        manager.addSystem(std::move(dirtySystem));
+        manager.updateSystems(nullptr, nullptr, dt);  // first call: everything is new
+        const size_t written = std::max<size_t>(entityCount / 100, 1);
+        std::uniform_int_distribution<size_t> writtenIndex(0, entityCount - 1);
+        dirtyReadMs = 0.0f;
+        for (int frame = 0; frame < frames; ++frame) {
+            size_t first = writtenIndex(random);
+            for (size_t i = 0; i < written; ++i) {
+                manager.get<TransformComponent>(created[(first + i) % entityCount])->position.y += dt;
+            }
+            start = Clock::now();
+            manager.updateSystems(nullptr, nullptr, dt);
+            dirtyReadMs += std::chrono::duration<float, std::milli>(Clock::now() - start).count() / frames;
+            dirtyCount += dirty->count;
+        }
+        manager.deleteSystem(dirty);
+
+        // Projectiles: every frame 1% of the entities (a run of distinct ones) die and as many are spawned
+        const size_t churn = std::max<size_t>(entityCount / 100, 1);
+        const int churnFrames = 100;
+        std::uniform_int_distribution<size_t> createdIndex(0, entityCount - 1);
+        slotsBeforeChurn = manager.getEntitySlotCount();
+        start = Clock::now();
+        for (int frame = 0; frame < churnFrames; ++frame) {
+            size_t first = createdIndex(random);
+            for (size_t i = 0; i < churn; ++i) {
+                EntityID& entity = created[(first + i) % entityCount];
+                manager.deleteEntity(entity);
+                entity = manager.createEntity();
+                manager.add<TransformComponent>(entity, positions[i]);
+                manager.add<MobileComponent>(entity, MobileComponent::DYNAMIC, velocities[i]);
+            }
+        }
+        churnMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count() / churnFrames;
+
+        // Same churn recorded in a command buffer, as a system would do, and played back once per frame:
+        // each new entity goes directly to its final archetype instead of moving once per component
+        CommandBuffer commands;
+        std::vector<EntityID> spawned;
+        start = Clock::now();
+        for (int frame = 0; frame < churnFrames; ++frame) {
+            size_t first = createdIndex(random);
+            for (size_t i = 0; i < churn; ++i) {
+                commands.destroyEntity(created[(first + i) % entityCount]);
+                EntityID entity = commands.createEntity();
+                commands.add<TransformComponent>(entity, positions[i]);
+                commands.add<MobileComponent>(entity, MobileComponent::DYNAMIC, velocities[i]);
+            }
+            spawned.clear();
+            manager.playback(commands, &spawned);
+            for (size_t i = 0; i < churn; ++i) {
+                created[(first + i) % entityCount] = spawned[i];
+            }
+        }
+        bufferedChurnMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count() / churnFrames;
+        slotsAfterChurn = manager.getEntitySlotCount();
+    }
+
+    LOG(Info) << "Create: maps " << mapCreateMs << " ms, archetypes " << archetypeCreateMs << " ms";
+    LOG(Info) << "Move (Transform + Mobile): maps " << mapUpdateMs << " ms / frame, archetypes " << archetypeUpdateMs
+              << " ms / frame (x" << mapUpdateMs / std::max(archetypeUpdateMs, 1.0e-6f) << ")";
+    LOG(Info) << lookupCount << " x 3 lookups by entity: strings + dynamic_cast " << mapLookupMs << " ms, type IDs "
+              << archetypeLookupMs << " ms";
+    LOG(Info) << "Read every transform: " << fullReadMs << " ms, only the changed ones (1% written per frame): "
+              << dirtyReadMs << " ms / frame, " << dirtyCount / frames << " visited";
+    LOG(Info) << "Churn (1% deleted and created per frame): " << churnMs << " ms / frame, through a command buffer "
+              << bufferedChurnMs << " ms / frame, entity slots " << slotsBeforeChurn << " -> " << slotsAfterChurn;
+    LOG(Info) << "Checksums: " << mapChecksum << " / " << archetypeChecksum;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    LOG_TERMINAL_ENABLE();
+    if (argc > 1) {
+        size_t entityCount = std::stoul(argv[1]);
+        if (entityCount == 0) {
+            LOG(Error) << "Entity count must be at least 1";
+            return 1;
+        }
+        runECSBenchmark(entityCount);
+    } else {
+        for (size_t entityCount : {10000, 100000, 1000000}) {
+            runECSBenchmark(entityCount);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,40 @@
+#version 330 core
+
+// Sommet compact d'un chunk (voir Voxel::ChunkVertex)
+layout (location = 0) in uvec2 aPacked;
+
+out vec3 FragPos;
+out vec4 ourColor;
+out vec2 TexCoord;
+out vec3 vertEyeSpacePos;
+flat out uint Layer;
+flat out uint Face;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+// Facteur d'occlusion ambiante pour ao = 0..3
+const float AO_FACTORS[4] = float[4](0.55, 0.7, 0.85, 1.0);
+
+void main() {
+    // Décodage du premier mot : position, face et coordonnées de texture
+    uint position = aPacked.x;
+    vec3 corner = vec3(float(position & 31u), float((position >> 5) & 31u), float((position >> 10) & 31u));
+    Face = (position >> 15) & 7u;
+    TexCoord = vec2(float((position >> 18) & 31u), float((position >> 23) & 31u));
+
+    // Décodage du second mot : couche de texture, lumière et occlusion ambiante
+    uint attributes = aPacked.y;
+    Layer = attributes & 4095u;
+    float light = float((attributes >> 12) & 15u) / 15.0;
+    float ao = AO_FACTORS[(attributes >> 16) & 3u];
+    ourColor = vec4(vec3(light * ao), 1.0);
+
+    // Les blocs sont centrés sur leurs coordonnées entières
+    vec3 aPos = corner - vec3(0.5);
+
+    FragPos = vec3(model * vec4(aPos, 1.0));
+    vertEyeSpacePos = vec3(view * model * vec4(aPos, 1.0));
+    gl_Position = projection * view * model * vec4(aPos, 1.0);
+}
@@ -0,0 +1,33 @@
+#version 330 core
+
+// Géométrie partagée (même disposition que Object::setupMesh)
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec4 aColor;
+layout (location = 2) in vec2 aTexCoord;
+layout (location = 3) in uint aFace;
+
+// Données par instance (voir InstancedRenderer::Instance)
+layout (location = 4) in mat4 aModel;
+layout (location = 8) in uvec3 aLayers;
+
+out vec3 FragPos;
+out vec4 ourColor;
+out vec2 TexCoord;
+out vec3 vertEyeSpacePos;
+flat out uint Layer;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+void main() {
+    FragPos = vec3(aModel * vec4(aPos, 1.0));
+
+    ourColor = aColor;
+    TexCoord = aTexCoord;
+
+    // Deux couches de 16 bits par composante : face paire dans les bits bas
+    Layer = (aLayers[aFace / 2u] >> ((aFace % 2u) * 16u)) & 65535u;
+
+    vertEyeSpacePos = vec3(view * aModel * vec4(aPos, 1.0));
+    gl_Position = projection * view * aModel * vec4(aPos, 1.0);
+}
@@ -0,0 +1,71 @@
+/**
+ * @file MPSCQueue.hpp
+ * @brief File sans verrou, plusieurs producteurs / un seul consommateur
+ */
+
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <utility>
+
+/*
+	Les producteurs empilent leurs éléments avec un compare-and-swap sur la tête
+	d'une pile (Treiber). Le consommateur récupère toute la pile d'un coup avec
+	un exchange, puis l'inverse pour rendre les éléments dans l'ordre d'arrivée.
+	Comme le consommateur ne dépile jamais un seul noeud par CAS, il n'y a pas
+	de problème ABA.
+*/
+template<typename T>
+class MPSCQueue {
+public:
+	MPSCQueue() : _head(nullptr), _pending(nullptr) {}
+
+	~MPSCQueue() {
+		T value;
+		while (pop(value)) {}
+	}
+
+	MPSCQueue(const MPSCQueue &) = delete;
+	MPSCQueue &operator=(const MPSCQueue &) = delete;
+
+	/// @brief Ajouter un élément (appelable depuis n'importe quel thread)
+	void push(T value) {
+		Node *node = new Node{std::move(value), _head.load(std::memory_order_relaxed)};
+		while (!_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {}
+	}
+
+	/// @brief Retirer le plus ancien élément (uniquement depuis le thread consommateur)
+	/// @return false si la file est vide
+	bool pop(T &value) {
+		if (!_pending) {
+			Node *stack = _head.exchange(nullptr, std::memory_order_acquire);
+			// Inverser la pile pour retrouver l'ordre FIFO
+			while (stack) {
+				Node *next = stack->next;
+				stack->next = _pending;
+				_pending = stack;
+				stack = next;
+			}
+			if (!_pending) {
+				return false;
+			}
+		}
+		Node *node = _pending;
+		_pending = node->next;
+		value = std::move(node->value);
+		delete node;
+		return true;
+	}
+
+private:
+	struct Node {
+		T value;
+		Node *next;
+	};
+
+	std::atomic<Node*> _head;	// pile partagée avec les producteurs
+	Node *_pending;				// éléments déjà récupérés par le consommateur
+};
+
+#endif // MPSC_QUEUE_HPP
@@ -0,0 +1,124 @@
+#include "PoolAllocator.hpp"
+#include <algorithm>
+#include <cxxabi.h>
+#include <cstdlib>
+#include "Logger.hpp"
+
+namespace {
+
+// Pools existants, pour les statistiques
+std::mutex &registryMutex() {
+	static std::mutex mutex;
+	return mutex;
+}
+
+std::vector<PoolAllocator *> &registry() {
+	static std::vector<PoolAllocator *> pools;
+	return pools;
+}
+
+} // namespace
+
+PoolAllocator::PoolAllocator(std::string name, size_t blockSize, size_t alignment, size_t blocksPerChunk)
+	: _name(std::move(name)), _alignment(std::max(alignment, alignof(FreeBlock))), _blocksPerChunk(std::max<size_t>(blocksPerChunk, 1)),
+	  _freeList(nullptr), _liveCount(0), _highWaterMark(0), _allocations(0) {
+	// Chaque bloc doit pouvoir contenir le chaînage de la liste libre, et rester aligné dans le chunk
+	_blockSize = std::max(blockSize, sizeof(FreeBlock));
+	_blockSize = (_blockSize + _alignment - 1) / _alignment * _alignment;
+
+	std::lock_guard<std::mutex> lock(registryMutex());
+	registry().push_back(this);
+}
+
+PoolAllocator::~PoolAllocator() {
+	{
+		std::lock_guard<std::mutex> lock(registryMutex());
+		auto &pools = registry();
+		pools.erase(std::remove(pools.begin(), pools.end(), this), pools.end());
+	}
+	if (_liveCount != 0) {
+		// Des objets vivent encore dans les chunks : mieux vaut les perdre que les libérer
+		LOG(Warning) << "Pool " << _name << " destroyed with " << _liveCount << " live blocks, chunks leaked";
+		return;
+	}
+	for (void *chunk : _chunks) {
+		::operator delete(chunk, std::align_val_t(_alignment));
+	}
+}
+
+void PoolAllocator::addChunk() {
+	char *chunk = static_cast<char *>(::operator new(_blockSize * _blocksPerChunk, std::align_val_t(_alignment)));
+	_chunks.push_back(chunk);
+	// Chaîner les blocs du chunk dans l'ordre des adresses
+	for (size_t i = _blocksPerChunk; i-- > 0;) {
+		FreeBlock *block = reinterpret_cast<FreeBlock *>(chunk + i * _blockSize);
+		block->next = _freeList;
+		_freeList = block;
+	}
+}
+
+void *PoolAllocator::allocate() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (!_freeList) {
+		addChunk();
+	}
+	FreeBlock *block = _freeList;
+	_freeList = block->next;
+	_liveCount++;
+	_allocations++;
+	_highWaterMark = std::max(_highWaterMark, _liveCount);
+	return block;
+}
+
+void PoolAllocator::deallocate(void *block) {
+	if (!block) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(_mutex);
+	FreeBlock *freeBlock = static_cast<FreeBlock *>(block);
+	freeBlock->next = _freeList;
+	_freeList = freeBlock;
+	_liveCount--;
+}
+
+PoolStats PoolAllocator::getStats() const {
+	std::lock_guard<std::mutex> lock(_mutex);
+	PoolStats stats;
+	stats.name = _name;
+	stats.blockSize = _blockSize;
+	stats.chunkCount = _chunks.size();
+	stats.capacity = _chunks.size() * _blocksPerChunk;
+	stats.liveCount = _liveCount;
+	stats.highWaterMark = _highWaterMark;
+	stats.allocations = _allocations;
+	stats.fragmentation = stats.capacity ? 1.0f - static_cast<float>(_liveCount) / stats.capacity : 0.0f;
+	return stats;
+}
+
+std::vector<PoolStats> PoolAllocator::getAllStats() {
+	std::lock_guard<std::mutex> lock(registryMutex());
+	std::vector<PoolStats> stats;
+	for (const PoolAllocator *pool : registry()) {
+		stats.push_back(pool->getStats());
+	}
+	return stats;
+}
+
+void PoolAllocator::logAllStats() {
+	for (const PoolStats &stats : getAllStats()) {
+		LOG(Info) << "Pool " << stats.name << " (" << stats.blockSize << " B blocks): " << stats.liveCount << " live, high-water mark "
+				  << stats.highWaterMark << ", " << stats.capacity << " reserved in " << stats.chunkCount << " chunks, "
+				  << stats.allocations << " allocations, " << stats.fragmentation * 100.0f << "% unused";
+	}
+}
+
+std::string demangleTypeName(const char *name) {
+	int status = 0;
+	char *demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+	if (status != 0 || !demangled) {
+		return name;
+	}
+	std::string result(demangled);
+	std::free(demangled);
+	return result;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file PoolAllocator.hpp
+ * @brief Pools de blocs de taille fixe, pour les petits objets alloués en grand nombre
+ */
+
+#ifndef POOL_ALLOCATOR_HPP
+#define POOL_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+/// @brief Statistiques d'un pool
+struct PoolStats {
+	std::string name;
+	size_t blockSize;
+	size_t chunkCount;
+	size_t capacity;		///< blocs réservés (chunkCount * blocs par chunk)
+	size_t liveCount;		///< blocs alloués actuellement
+	size_t highWaterMark;	///< maximum de liveCount depuis la création
+	size_t allocations;		///< nombre total d'allocations
+	/// @brief Part des blocs réservés inutilisés (0 = pool plein, 1 = pool vide)
+	float fragmentation;
+};
+
+/*
+	Les blocs sont découpés dans des chunks contigus, jamais rendus au système :
+	un bloc libéré est chaîné dans une liste libre (le pointeur vers le suivant est
+	écrit dans le bloc lui-même), et réutilisé en premier (LIFO, encore en cache).
+	allocate et deallocate sont en O(1). Un mutex protège le pool, car des composants
+	peuvent être créés depuis les systèmes exécutés en parallèle.
+*/
+class PoolAllocator {
+public:
+	/// @param name Nom affiché dans les statistiques
+	/// @param blockSize Taille d'un bloc (au moins celle d'un pointeur)
+	/// @param alignment Alignement des blocs
+	/// @param blocksPerChunk Nombre de blocs réservés à la fois
+	PoolAllocator(std::string name, size_t blockSize, size_t alignment, size_t blocksPerChunk = 256);
+	~PoolAllocator();
+
+	PoolAllocator(const PoolAllocator &) = delete;
+	PoolAllocator &operator=(const PoolAllocator &) = delete;
+
+	void *allocate();
+	/// @param block Bloc rendu par allocate de ce pool
+	void deallocate(void *block);
+
+	size_t getBlockSize() const { return _blockSize; }
+	PoolStats getStats() const;
+
+	/// @brief Statistiques de tous les pools existants
+	static std::vector<PoolStats> getAllStats();
+	static void logAllStats();
+
+private:
+	struct FreeBlock {
+		FreeBlock *next;
+	};
+
+	void addChunk();
+
+	std::string _name;
+	size_t _blockSize;
+	size_t _alignment;
+	size_t _blocksPerChunk;
+	std::vector<void *> _chunks;
+	FreeBlock *_freeList;
+	size_t _liveCount;
+	size_t _highWaterMark;
+	size_t _allocations;
+	mutable std::mutex _mutex;
+};
+
+/// @brief Nom lisible d'un type (démanglé)
+std::string demangleTypeName(const char *name);
+
+/// @brief Pool des blocs de type Block, regroupés sous le nom du type Owner
+/// Le pool n'est jamais détruit : des objets peuvent encore être libérés pendant la destruction
+/// des variables statiques, et ses chunks restent accessibles jusqu'à la fin du programme.
+template<typename Owner, typename Block>
+PoolAllocator &getPool() {
+	static PoolAllocator *pool = new PoolAllocator(demangleTypeName(typeid(Owner).name()), sizeof(Block), alignof(Block));
+	return *pool;
+}
+
+/// @brief Allocateur standard qui prend ses blocs dans getPool<Owner, U>()
+/// Utilisable avec std::allocate_shared (le bloc contient l'objet et son compteur de références)
+/// et avec les conteneurs à noeuds (std::map, std::list). Les allocations de plusieurs
+/// éléments à la fois (std::vector) passent par operator new.
+template<typename T, typename Owner = T>
+class PoolStdAllocator {
+public:
+	using value_type = T;
+
+	template<typename U>
+	struct rebind {
+		using other = PoolStdAllocator<U, Owner>;
+	};
+
+	PoolStdAllocator() noexcept = default;
+	template<typename U>
+	PoolStdAllocator(const PoolStdAllocator<U, Owner> &) noexcept {}
+
+	T *allocate(size_t n) {
+		if (n == 1) {
+			return static_cast<T *>(getPool<Owner, T>().allocate());
+		}
+		return static_cast<T *>(::operator new(n * sizeof(T)));
+	}
+
+	void deallocate(T *pointer, size_t n) noexcept {
+		if (n == 1) {
+			getPool<Owner, T>().deallocate(pointer);
+		} else {
+			::operator delete(pointer);
+		}
+	}
+
+	template<typename U>
+	bool operator==(const PoolStdAllocator<U, Owner> &) const noexcept { return true; }
+	template<typename U>
+	bool operator!=(const PoolStdAllocator<U, Owner> &) const noexcept { return false; }
+};
+
+/// @brief Équivalent de std::make_shared, avec l'objet et son compteur dans le pool de T
+template<typename T, typename... Args>
+std::shared_ptr<T> makePooled(Args &&...args) {
+	return std::allocate_shared<T>(PoolStdAllocator<T>(), std::forward<Args>(args)...);
+}
+
+#endif // POOL_ALLOCATOR_HPP
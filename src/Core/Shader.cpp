@@ -2,6 +2,7 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <cstring>
 #include <glm/gtc/type_ptr.hpp>
 #include "Logger.hpp"
 
@@ -26,6 +27,10 @@ Shader::Shader(const std::string &vertexPath, const std::string &fragmentPath) :
 	glAttachShader(_programID, _fragmentShaderID);
 	glLinkProgram(_programID);
 	checkCompileErrors(_programID, "PROGRAM");
+
+	if (_error.empty()) {
+		loadUniforms();
+	}
 }
 
 Shader::~Shader() {
@@ -60,60 +65,204 @@ void Shader::cleanup() {
 	glDeleteProgram(_programID);
 }
 
+void Shader::loadUniforms() {
+	_uniforms.clear();
+	_uniformValues.clear();
+
+	GLint count = 0;
+	glGetProgramiv(_programID, GL_ACTIVE_UNIFORMS, &count);
+
+	GLchar name[256];
+	for (GLint i = 0; i < count; ++i) {
+		GLsizei length = 0;
+		GLint size = 0;
+		GLenum type = 0;
+		glGetActiveUniform(_programID, i, sizeof(name), &length, &size, &type, name);
+
+		std::string uniformName(name, length);
+		// Les tableaux sont listés sous la forme "nom[0]", seul le dernier indice variant ("lights[0].colors[0]") :
+		// chaque élément a son propre emplacement, et l'élément 0 répond aussi au nom sans indice
+		const bool isArray = uniformName.size() > 3 && uniformName.compare(uniformName.size() - 3, 3, "[0]") == 0;
+		std::string baseName = isArray ? uniformName.substr(0, uniformName.rfind('[')) : uniformName;
+		if (!isArray) {
+			size = 1;
+		}
+
+		for (GLint element = 0; element < size; ++element) {
+			std::string elementName = isArray ? baseName + "[" + std::to_string(element) + "]" : uniformName;
+			GLint location = glGetUniformLocation(_programID, elementName.c_str());
+			if (location < 0) {
+				continue;
+			}
+			UniformHandle uniform = {location, static_cast<int>(_uniformValues.size())};
+			_uniformValues.emplace_back();
+			_uniforms[elementName] = uniform;
+			if (element == 0) {
+				_uniforms[baseName] = uniform;
+			}
+		}
+	}
+	LOG(Debug) << "Program has " << _uniforms.size() << " uniform names for " << _uniformValues.size() << " locations";
+}
+
+UniformHandle Shader::getUniform(const std::string &name) const {
+	auto it = _uniforms.find(name);
+	if (it == _uniforms.end()) {
+		// Uniforme inexistant ou éliminé par le compilateur : comme avec l'emplacement -1, les envois sont ignorés
+		return UniformHandle();
+	}
+	return it->second;
+}
+
+GLuint Shader::getProgramID() const {
+	return _programID;
+}
+
+bool Shader::hasUniform(const std::string &name) const {
+	return _uniforms.find(name) != _uniforms.end();
+}
+
+const UniformStats &Shader::getUniformStats() const {
+	return _uniformStats;
+}
+
+void Shader::resetUniformStats() const {
+	_uniformStats = UniformStats();
+}
+
+bool Shader::updateShadow(UniformHandle uniform, const void *value, size_t size) const {
+	if (!uniform.isValid()) {
+		return false;
+	}
+	UniformValue &shadow = _uniformValues[uniform.slot];
+	if (shadow.set && std::memcmp(shadow.data.data(), value, size) == 0) {
+		_uniformStats.skipped++;
+		return false;
+	}
+	std::memcpy(shadow.data.data(), value, size);
+	shadow.set = true;
+	_uniformStats.uploads++;
+	return true;
+}
+
 void Shader::setBool(const std::string &name, bool value) const {
-	glUniform1i(glGetUniformLocation(_programID, name.c_str()), (int)value);
+	setBool(getUniform(name), value);
 }
 
 void Shader::setInt(const std::string &name, int value) const {
-	glUniform1i(glGetUniformLocation(_programID, name.c_str()), value);
+	setInt(getUniform(name), value);
 }
 
 void Shader::setUint(const std::string &name, unsigned int value) const {
-	glUniform1ui(glGetUniformLocation(_programID, name.c_str()), value);
+	setUint(getUniform(name), value);
 }
 
 void Shader::setFloat(const std::string &name, float value) const {
-	glUniform1f(glGetUniformLocation(_programID, name.c_str()), value);
+	setFloat(getUniform(name), value);
 }
 
 void Shader::setDouble(const std::string &name, double value) const {
-	glUniform1d(glGetUniformLocation(_programID, name.c_str()), value);
+	setDouble(getUniform(name), value);
 }
 
 void Shader::setVec2(const std::string &name, const glm::vec2 &value) const {
-	glUniform2fv(glGetUniformLocation(_programID, name.c_str()), 1, glm::value_ptr(value));
+	setVec2(getUniform(name), value);
 }
 
 void Shader::setVec2(const std::string &name, float x, float y) const {
-	glUniform2f(glGetUniformLocation(_programID, name.c_str()), x, y);
+	setVec2(getUniform(name), glm::vec2(x, y));
 }
 
 void Shader::setVec3(const std::string &name, const glm::vec3 &value) const {
-	glUniform3fv(glGetUniformLocation(_programID, name.c_str()), 1, glm::value_ptr(value));
+	setVec3(getUniform(name), value);
 }
 
 void Shader::setVec3(const std::string &name, float x, float y, float z) const {
-	glUniform3f(glGetUniformLocation(_programID, name.c_str()), x, y, z);
+	setVec3(getUniform(name), glm::vec3(x, y, z));
 }
 
 void Shader::setVec4(const std::string &name, const glm::vec4 &value) const {
-	glUniform4fv(glGetUniformLocation(_programID, name.c_str()), 1, glm::value_ptr(value));
+	setVec4(getUniform(name), value);
 }
 
 void Shader::setVec4(const std::string &name, float x, float y, float z, float w) const {
-	glUniform4f(glGetUniformLocation(_programID, name.c_str()), x, y, z, w);
+	setVec4(getUniform(name), glm::vec4(x, y, z, w));
 }
 
 void Shader::setMat2(const std::string &name, const glm::mat2 &value) const {
-	glUniformMatrix2fv(glGetUniformLocation(_programID, name.c_str()), 1, GL_FALSE, glm::value_ptr(value));
+	setMat2(getUniform(name), value);
 }
 
 void Shader::setMat3(const std::string &name, const glm::mat3 &value) const {
-	glUniformMatrix3fv(glGetUniformLocation(_programID, name.c_str()), 1, GL_FALSE, glm::value_ptr(value));
+	setMat3(getUniform(name), value);
 }
 
 void Shader::setMat4(const std::string &name, const glm::mat4 &value) const {
-	glUniformMatrix4fv(glGetUniformLocation(_programID, name.c_str()), 1, GL_FALSE, glm::value_ptr(value));
+	setMat4(getUniform(name), value);
+}
+
+void Shader::setBool(UniformHandle uniform, bool value) const {
+	setInt(uniform, (int)value);
+}
+
+void Shader::setInt(UniformHandle uniform, int value) const {
+	if (updateShadow(uniform, &value, sizeof(value))) {
+		glUniform1i(uniform.location, value);
+	}
+}
+
+void Shader::setUint(UniformHandle uniform, unsigned int value) const {
+	if (updateShadow(uniform, &value, sizeof(value))) {
+		glUniform1ui(uniform.location, value);
+	}
+}
+
+void Shader::setFloat(UniformHandle uniform, float value) const {
+	if (updateShadow(uniform, &value, sizeof(value))) {
+		glUniform1f(uniform.location, value);
+	}
+}
+
+void Shader::setDouble(UniformHandle uniform, double value) const {
+	if (updateShadow(uniform, &value, sizeof(value))) {
+		glUniform1d(uniform.location, value);
+	}
+}
+
+void Shader::setVec2(UniformHandle uniform, const glm::vec2 &value) const {
+	if (updateShadow(uniform, glm::value_ptr(value), sizeof(float) * 2)) {
+		glUniform2fv(uniform.location, 1, glm::value_ptr(value));
+	}
+}
+
+void Shader::setVec3(UniformHandle uniform, const glm::vec3 &value) const {
+	if (updateShadow(uniform, glm::value_ptr(value), sizeof(float) * 3)) {
+		glUniform3fv(uniform.location, 1, glm::value_ptr(value));
+	}
+}
+
+void Shader::setVec4(UniformHandle uniform, const glm::vec4 &value) const {
+	if (updateShadow(uniform, glm::value_ptr(value), sizeof(float) * 4)) {
+		glUniform4fv(uniform.location, 1, glm::value_ptr(value));
+	}
+}
+
+void Shader::setMat2(UniformHandle uniform, const glm::mat2 &value) const {
+	if (updateShadow(uniform, glm::value_ptr(value), sizeof(float) * 4)) {
+		glUniformMatrix2fv(uniform.location, 1, GL_FALSE, glm::value_ptr(value));
+	}
+}
+
+void Shader::setMat3(UniformHandle uniform, const glm::mat3 &value) const {
+	if (updateShadow(uniform, glm::value_ptr(value), sizeof(float) * 9)) {
+		glUniformMatrix3fv(uniform.location, 1, GL_FALSE, glm::value_ptr(value));
+	}
+}
+
+void Shader::setMat4(UniformHandle uniform, const glm::mat4 &value) const {
+	if (updateShadow(uniform, glm::value_ptr(value), sizeof(float) * 16)) {
+		glUniformMatrix4fv(uniform.location, 1, GL_FALSE, glm::value_ptr(value));
+	}
 }
 
 std::string Shader::loadShaderSource(const std::string &filePath) {
@@ -16,8 +16,25 @@
 
 #include <GL/glew.h>
 #include <string>
+#include <vector>
+#include <array>
+#include <unordered_map>
 #include <glm/glm.hpp>
 
+/// @brief Uniforme résolu une fois (Shader::getUniform) et gardé par l'appelant pour éviter la recherche par nom
+struct UniformHandle {
+	GLint location = -1;
+	int slot = -1;		// indice de la valeur mémorisée dans le shader
+
+	bool isValid() const { return slot >= 0; }
+};
+
+/// @brief Envois d'uniformes effectués / évités car la valeur n'avait pas changé
+struct UniformStats {
+	unsigned int uploads = 0;
+	unsigned int skipped = 0;
+};
+
 class Shader {
 public:
 	// le constructeur lit et construit le shader
@@ -34,7 +51,16 @@ public:
 	void unuse() const;
 
 	void cleanup();
+
+	GLuint getProgramID() const;
 	
+	/// @brief Uniforme actif du programme (liste construite à l'édition des liens), invalide s'il n'existe pas
+	UniformHandle getUniform(const std::string &name) const;
+	bool hasUniform(const std::string &name) const;
+
+	const UniformStats &getUniformStats() const;
+	void resetUniformStats() const;
+
 	// fonctions utiles pour l'uniform
 	void setBool(const std::string &name, bool value) const;
 	void setInt(const std::string &name, int value) const;
@@ -51,7 +77,32 @@ public:
 	void setMat3(const std::string &name, const glm::mat3 &value) const;
 	void setMat4(const std::string &name, const glm::mat4 &value) const;
 
+	// mêmes fonctions avec un uniforme déjà résolu, l'envoi est ignoré si la valeur n'a pas changé
+	void setBool(UniformHandle uniform, bool value) const;
+	void setInt(UniformHandle uniform, int value) const;
+	void setUint(UniformHandle uniform, unsigned int value) const;
+	void setFloat(UniformHandle uniform, float value) const;
+	void setDouble(UniformHandle uniform, double value) const;
+	void setVec2(UniformHandle uniform, const glm::vec2 &value) const;
+	void setVec3(UniformHandle uniform, const glm::vec3 &value) const;
+	void setVec4(UniformHandle uniform, const glm::vec4 &value) const;
+	void setMat2(UniformHandle uniform, const glm::mat2 &value) const;
+	void setMat3(UniformHandle uniform, const glm::mat3 &value) const;
+	void setMat4(UniformHandle uniform, const glm::mat4 &value) const;
+
 private:
+	/// @brief Dernière valeur envoyée pour un uniforme (une matrice 4x4 au plus)
+	struct UniformValue {
+		std::array<unsigned char, sizeof(float) * 16> data;
+		bool set = false;
+	};
+
+	/// @brief Lister les uniformes actifs avec glGetActiveUniform
+	void loadUniforms();
+
+	/// @brief Comparer à la valeur mémorisée et la remplacer, false si l'envoi est inutile
+	bool updateShadow(UniformHandle uniform, const void *value, size_t size) const;
+
 	GLuint _programID;
 	GLuint _vertexShaderID;
 	GLuint _fragmentShaderID;
@@ -60,6 +111,10 @@ private:
 	void checkCompileErrors(GLuint shader, std::string type);
 
 	std::string _error;
+
+	std::unordered_map<std::string, UniformHandle> _uniforms;
+	mutable std::vector<UniformValue> _uniformValues;
+	mutable UniformStats _uniformStats;
 };
 
 #endif // SHADER_HPP
@@ -177,13 +177,30 @@ glm::ivec2 Texture::getSize() const {
     return _size;
 }
 
+GLuint Texture::getID() const {
+    return _textureID;
+}
+
+bool Texture::getPixels(std::vector<unsigned char> &pixels) const {
+    if (!_isLoaded) {
+        LOG(Error) << "Texture is not loaded";
+        return false;
+    }
+
+    pixels.resize(static_cast<size_t>(_size.x) * _size.y * 4);
+    glBindTexture(GL_TEXTURE_2D, _textureID);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return true;
+}
+
 void Texture::use() const {
     if (!_isLoaded) {
         LOG(Error) << "Texture is not loaded";
         return;
     }
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    // Le mélange est activé une fois pour toutes dans Game::initOpenGL
     glBindTexture(GL_TEXTURE_2D, _textureID);
 }
 
@@ -30,6 +30,10 @@ public:
     glm::vec4 getPixel(const glm::ivec2 &position) const;
 
     glm::ivec2 getSize() const;
+    GLuint getID() const;
+
+    // Copier les pixels du niveau 0 en RGBA 8 bits (lecture depuis le GPU)
+    bool getPixels(std::vector<unsigned char> &pixels) const;
 
     void use() const;
     void bind() const;
@@ -0,0 +1,115 @@
+#include "TextureArray.hpp"
+#include "Logger.hpp"
+
+TextureArray::TextureArray()
+    : _isLoaded(false), _textureID(0), _size(0, 0), _layerCount(0) {
+}
+
+TextureArray::~TextureArray() {
+    free();
+}
+
+void TextureArray::free() {
+    if (_isLoaded) {
+        glDeleteTextures(1, &_textureID);
+        _isLoaded = false;
+        _layerCount = 0;
+    }
+}
+
+bool TextureArray::createFromTextures(const std::vector<TexturePtr> &textures, bool linearOrNearestFilter) {
+    if (textures.empty()) {
+        LOG(Error) << "No texture to put in the texture array";
+        return false;
+    }
+    GLint maxLayers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    if (textures.size() > static_cast<size_t>(maxLayers)) {
+        LOG(Error) << "Too many layers for a texture array: " << textures.size() << " (max " << maxLayers << ")";
+        return false;
+    }
+    free(); // Free any existing texture
+
+    _size = textures.front()->getSize();
+    _layerCount = textures.size();
+
+    glGenTextures(1, &_textureID);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, _textureID);
+
+    if (!_textureID) {
+        LOG(Error) << "Failed to create texture array";
+        return false;
+    }
+
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, _size.x, _size.y, _layerCount, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    std::vector<unsigned char> pixels, resized;
+    for (unsigned int layer = 0; layer < _layerCount; ++layer) {
+        if (!textures[layer]->getPixels(pixels)) {
+            LOG(Error) << "Failed to read texture for layer " << layer;
+            continue;
+        }
+
+        const unsigned char *data = pixels.data();
+        glm::ivec2 size = textures[layer]->getSize();
+        if (size != _size) {
+            LOG(Warning) << "Texture layer " << layer << " resized from " << size.x << "x" << size.y << " to " << _size.x << "x" << _size.y;
+            resized.resize(static_cast<size_t>(_size.x) * _size.y * 4);
+            for (int y = 0; y < _size.y; ++y) {
+                int srcY = y * size.y / _size.y;
+                for (int x = 0; x < _size.x; ++x) {
+                    int srcX = x * size.x / _size.x;
+                    for (int c = 0; c < 4; ++c) {
+                        resized[(y * _size.x + x) * 4 + c] = pixels[(srcY * size.x + srcX) * 4 + c];
+                    }
+                }
+            }
+            data = resized.data();
+        }
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, _size.x, _size.y, 1, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    }
+
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+    // Les quads fusionnés des chunks ont des coordonnées au-delà de 1 : la texture est répétée sur chaque bloc
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+    if (linearOrNearestFilter) {
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    } else {
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    }
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    _isLoaded = true;
+    return true;
+}
+
+glm::ivec2 TextureArray::getSize() const {
+    return _size;
+}
+
+GLuint TextureArray::getID() const {
+    return _textureID;
+}
+
+unsigned int TextureArray::getLayerCount() const {
+    return _layerCount;
+}
+
+bool TextureArray::isLoaded() const {
+    return _isLoaded;
+}
+
+void TextureArray::use() const {
+    if (!_isLoaded) {
+        LOG(Error) << "Texture array is not loaded";
+        return;
+    }
+    glBindTexture(GL_TEXTURE_2D_ARRAY, _textureID);
+}
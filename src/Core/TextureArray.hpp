@@ -0,0 +1,42 @@
+#ifndef TEXTURE_ARRAY_HPP
+#define TEXTURE_ARRAY_HPP
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <memory>
+#include "Texture.hpp"
+
+/// @brief Tableau de textures de même taille (GL_TEXTURE_2D_ARRAY), une couche par texture :
+/// toutes les faces d'un mesh peuvent être dessinées sans changer de texture
+class TextureArray {
+public:
+    TextureArray();
+    ~TextureArray();
+
+    TextureArray(const TextureArray &) = delete;
+    TextureArray &operator=(const TextureArray &) = delete;
+
+    void free();
+
+    /// @brief Copier chaque texture dans une couche, dans l'ordre du vecteur (la couche i est textures[i])
+    /// Les textures de taille différente de la première sont redimensionnées au plus proche voisin
+    bool createFromTextures(const std::vector<TexturePtr> &textures, bool linearOrNearestFilter = false);
+
+    glm::ivec2 getSize() const;
+    GLuint getID() const;
+    unsigned int getLayerCount() const;
+    bool isLoaded() const;
+
+    void use() const;
+
+private:
+    bool _isLoaded;
+    GLuint _textureID;
+    glm::ivec2 _size;
+    unsigned int _layerCount;
+};
+
+using TextureArrayPtr = std::shared_ptr<TextureArray>;
+
+#endif // TEXTURE_ARRAY_HPP
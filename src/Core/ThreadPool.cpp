@@ -0,0 +1,51 @@
+#include "ThreadPool.hpp"
+
+ThreadPool::ThreadPool(unsigned int threadCount) : _stopping(false) {
+	if (threadCount == 0) {
+		unsigned int cores = std::thread::hardware_concurrency();
+		threadCount = (cores > 1) ? cores - 1 : 1; // on laisse un coeur au thread de rendu
+	}
+	for (unsigned int i = 0; i < threadCount; ++i) {
+		_threads.emplace_back(&ThreadPool::workerLoop, this);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stopping = true;
+		_tasks.clear();
+	}
+	_condition.notify_all();
+	for (auto &thread : _threads) {
+		thread.join();
+	}
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_tasks.push_back(std::move(task));
+	}
+	_condition.notify_one();
+}
+
+unsigned int ThreadPool::getThreadCount() const {
+	return static_cast<unsigned int>(_threads.size());
+}
+
+void ThreadPool::workerLoop() {
+	while (true) {
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_condition.wait(lock, [this] { return _stopping || !_tasks.empty(); });
+			if (_stopping) {
+				return;
+			}
+			task = std::move(_tasks.front());
+			_tasks.pop_front();
+		}
+		task();
+	}
+}
@@ -0,0 +1,40 @@
+/**
+ * @file ThreadPool.hpp
+ * @brief Groupe de threads exécutant des tâches en arrière-plan
+ */
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+class ThreadPool {
+public:
+	/// @param threadCount Nombre de threads (0 = nombre de coeurs - 1, au moins 1)
+	ThreadPool(unsigned int threadCount = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool &operator=(const ThreadPool &) = delete;
+
+	/// @brief Ajouter une tâche à exécuter par un des threads
+	void submit(std::function<void()> task);
+
+	unsigned int getThreadCount() const;
+
+private:
+	void workerLoop();
+
+	std::vector<std::thread> _threads;
+	std::deque<std::function<void()>> _tasks;
+	std::mutex _mutex;
+	std::condition_variable _condition;
+	bool _stopping;
+};
+
+#endif // THREAD_POOL_HPP
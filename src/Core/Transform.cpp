@@ -43,31 +43,48 @@ glm::mat4 buildScale(float x, float y, float z) {
 
 
 
-glm::mat4 Transform::getTransformMatrix() {
-    if (!_needsUpdate) {
-        return _model;
-    }
-
-    if (_eulerRot != _oldEulerRot) {
-        _orientation = glm::quat(glm::radians(_eulerRot));
-        _oldEulerRot = _eulerRot;
+const glm::mat4& Transform::getLocalMatrix() const {
+    if (_localDirty) {
+        _local = glm::translate(glm::mat4(1.0f), _position) *
+                 glm::mat4_cast(_orientation) *
+                 glm::scale(glm::mat4(1.0f), glm::vec3(_scale));
     }
+    return _local;
+}
 
-    _model = glm::translate(glm::mat4(1.0f), _position) *
-             glm::mat4_cast(_orientation) *
-             glm::scale(glm::mat4(1.0f), glm::vec3(_scale));
+const glm::mat4& Transform::getWorldMatrix() const {
+    bool changed = _localDirty;
+    getLocalMatrix();
+    _localDirty = false;
 
-    _needsUpdate = false;
+    if (_parent != nullptr) {
+        // The parent is brought up to date first: its version tells whether it moved since our last read
+        const glm::mat4& parentWorld = _parent->getWorldMatrix();
+        if (changed || _parent->_version != _parentVersion) {
+            _world = parentWorld * _local;
+            _parentVersion = _parent->_version;
+            changed = true;
+        }
+    } else if (changed) {
+        _world = _local;
+    }
 
-    return getMatrix();
+    if (changed) {
+        _version++;
+    }
+    return _world;
 }
 
-glm::mat4 Transform::getMatrix() const {
-    if (_parent != nullptr) {
-        return _parent->getTransformMatrix() * _model;
-    } else {
-        return _model;
+bool Transform::hasChanged() const {
+    if (_localDirty) {
+        return true;
     }
+    return _parent != nullptr && (_parent->hasChanged() || _parent->_version != _parentVersion);
+}
+
+uint32_t Transform::getVersion() const {
+    getWorldMatrix();
+    return _version;
 }
 
 glm::vec3 Transform::getRight() const {
@@ -1,6 +1,7 @@
 #ifndef TRANSFORM_HPP
 #define TRANSFORM_HPP
 
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
 
@@ -21,50 +22,68 @@ glm::mat4 buildScale(float x, float y, float z);
 
 
 
+// Position, orientation and scale of an object, optionally relative to a parent transform.
+// Matrices are rebuilt lazily: setters only mark the transform dirty, and the world matrix is
+// recomputed on the next read if the transform or one of its parents changed since the last one.
 class Transform {
 public:
     Transform(const glm::vec3& pos = glm::vec3(0.0f), const glm::vec3& rot = glm::vec3(0.0f), float sc = 1.0f)
-        : _position(pos), _eulerRot(rot), _scale(sc), _parent(nullptr), _model(1.0f), _needsUpdate(true) {}
+        : _position(pos), _orientation(glm::quat(glm::radians(rot))), _eulerRot(rot), _scale(sc), _parent(nullptr),
+          _local(1.0f), _world(1.0f), _localDirty(true), _version(0), _parentVersion(0) {}
 
-    glm::mat4 getTransformMatrix();
-    bool hasChanged() { return _needsUpdate; }
+    // world matrix (parent * local)
+    glm::mat4 getTransformMatrix() const { return getWorldMatrix(); }
+    const glm::mat4& getLocalMatrix() const;
+    const glm::mat4& getWorldMatrix() const;
+
+    // true if the world matrix will be recomputed on the next read
+    bool hasChanged() const;
+
+    // incremented each time the world matrix is recomputed: compare with a saved value to detect a move
+    uint32_t getVersion() const;
 
     void translatePosition(const glm::vec3& translation) {
         _position += translation;
-        _needsUpdate = true;
+        _localDirty = true;
     }
 
     float getScale() const { return _scale; }
     const glm::vec3& getPos() const { return _position; }
     const glm::vec3& getEulerRot() const { return _eulerRot; }
     const glm::quat& getOrientation() const { return _orientation; }
-    float* getScalePtr() { return &_scale; }
+    float* getScalePtr() { _localDirty = true; return &_scale; }
+    // the position may be written through the reference: it is considered modified
+    glm::vec3& getPosRef() { _localDirty = true; return _position; }
 
     void setEulerRot(float x, float y, float z) {
-        _oldEulerRot = _eulerRot;
         _eulerRot = glm::vec3(x, y, z);
-        _needsUpdate = true;
+        _orientation = glm::quat(glm::radians(_eulerRot));
+        _localDirty = true;
     }
 
     void setPos(const glm::vec3& pos) {
         _position = pos;
-        _needsUpdate = true;
+        _localDirty = true;
     }
 
     void setRot(const glm::quat& rot) {
         _orientation = rot;
-        _needsUpdate = true;
+        _localDirty = true;
     }
 
     void setScale(float sc) {
         _scale = sc;
-        _needsUpdate = true;
+        _localDirty = true;
     }
 
-    void setParent(Transform* p) {
+    // the parent must outlive this transform (or be reset to nullptr before being destroyed)
+    void setParent(const Transform* p) {
         _parent = p;
+        _localDirty = true;
     }
 
+    const Transform* getParent() const { return _parent; }
+
     glm::vec3 getRight() const;
     glm::vec3 getUp() const;
     glm::vec3 getBackward() const;
@@ -72,22 +91,18 @@ public:
     glm::vec3 getGlobalScale() const;
 
 private:
-    glm::mat4 getMatrix() const;
-
     glm::vec3 _position;
     glm::quat _orientation;
     glm::vec3 _eulerRot;
     float _scale;
 
-    glm::vec3 _oldPos;
-    glm::vec3 _oldEulerRot;
-    glm::quat _oldOrientation;
-    float _oldScale;
-
-    Transform* _parent;
+    const Transform* _parent;
 
-    glm::mat4 _model;
-    bool _needsUpdate;
+    mutable glm::mat4 _local;
+    mutable glm::mat4 _world;
+    mutable bool _localDirty;
+    mutable uint32_t _version;
+    mutable uint32_t _parentVersion;  // parent version used for the current world matrix
 };
 
 #endif // TRANSFORM_HPP
\ No newline at end of file
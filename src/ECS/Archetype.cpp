@@ -0,0 +1,62 @@
+#include "Archetype.hpp"
+#include <algorithm>
+
+Archetype::Archetype(std::vector<ComponentTypeID> types, std::vector<std::unique_ptr<ColumnBase>> columns)
+    : types(std::move(types)), columns(std::move(columns)) {
+    addEdges.fill(nullptr);
+    removeEdges.fill(nullptr);
+    columnIndices.fill(-1);
+    for (size_t i = 0; i < this->types.size(); ++i) {
+        signature.set(this->types[i]);
+        columnIndices[this->types[i]] = static_cast<int8_t>(i);
+    }
+}
+
+size_t Archetype::pushEntity(EntityID entity) {
+    entities.push_back(entity);
+    return entities.size() - 1;
+}
+
+EntityID Archetype::popRow(size_t row) {
+    EntityID moved = INVALID_ENTITY;
+    if (row + 1 != entities.size()) {
+        entities[row] = entities.back();
+        moved = entities[row];
+    }
+    entities.pop_back();
+    return moved;
+}
+
+EntityID Archetype::removeRow(size_t row) {
+    for (auto& column : columns) {
+        column->removeRow(row);
+    }
+    return popRow(row);
+}
+
+EntityID Archetype::moveRow(size_t row, Archetype& destination) {
+    for (size_t i = 0; i < types.size(); ++i) {
+        int target = destination.getColumnIndex(types[i]);
+        if (target >= 0) {
+            columns[i]->moveRow(row, *destination.columns[target]);
+        } else {
+            columns[i]->removeRow(row);
+        }
+    }
+    destination.pushEntity(entities[row]);
+    return popRow(row);
+}
+
+void Archetype::reserveExtra(size_t count) {
+    size_t needed = entities.size() + count;
+    if (needed > entities.capacity()) {
+        reserve(std::max(needed, entities.capacity() * 2));
+    }
+}
+
+void Archetype::reserve(size_t count) {
+    entities.reserve(count);
+    for (auto& column : columns) {
+        column->reserve(count);
+    }
+}
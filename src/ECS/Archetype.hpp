@@ -0,0 +1,169 @@
+#ifndef ARCHETYPE_HPP
+#define ARCHETYPE_HPP
+
+#include <vector>
+#include <array>
+#include <memory>
+#include <cstdint>
+
+#include "Entity.hpp"
+#include "ComponentType.hpp"
+#include "ChangeTick.hpp"
+
+// Type-erased column of components: structural changes (add, remove, move between archetypes)
+// go through these virtual functions, while systems reach the typed vector directly
+class ColumnBase {
+public:
+    virtual ~ColumnBase() = default;
+
+    // Added / changed tick of each row, kept parallel to the components (moved and removed with them)
+    std::vector<ComponentTicks> ticks;
+    // Latest tick of any row, so that Changed / Added filters skip an untouched column at once
+    Tick addedTick = 0;
+    Tick changedTick = 0;
+
+    // Ticks of the component just pushed at the end of the column
+    void pushTicks(Tick tick) {
+        ticks.push_back({tick, tick});
+        touchAdded(tick);
+        touchChanged(tick);
+    }
+
+    void markChanged(size_t row, Tick tick) {
+        ticks[row].changed = tick;
+        touchChanged(tick);
+    }
+
+    // The column ticks of an empty column may be far behind (not comparable any more):
+    // the first row sets them
+    void touchAdded(Tick tick) {
+        if (ticks.size() == 1 || isNewer(tick, addedTick)) addedTick = tick;
+    }
+
+    void touchChanged(Tick tick) {
+        if (ticks.size() == 1 || isNewer(tick, changedTick)) changedTick = tick;
+    }
+
+    // Raise every tick older than floor to floor (see Manager::clampChangeTicks)
+    void clampTicks(Tick floor) {
+        for (auto& rowTicks : ticks) {
+            clampTick(rowTicks.added, floor);
+            clampTick(rowTicks.changed, floor);
+        }
+        clampTick(addedTick, floor);
+        clampTick(changedTick, floor);
+    }
+
+    // New empty column of the same component type
+    virtual std::unique_ptr<ColumnBase> createEmpty() const = 0;
+    // Move the component at row to the end of other (same type), then remove the row here
+    virtual void moveRow(size_t row, ColumnBase& other) = 0;
+    // Remove the component at row: the last component takes its place
+    virtual void removeRow(size_t row) = 0;
+    virtual void reserve(size_t count) = 0;
+    virtual size_t size() const = 0;
+
+protected:
+    void moveTicks(size_t row, ColumnBase& other) {
+        const ComponentTicks moved = ticks[row];
+        other.ticks.push_back(moved);
+        other.touchAdded(moved.added);
+        other.touchChanged(moved.changed);
+    }
+
+    void removeTicks(size_t row) {
+        ticks[row] = ticks.back();
+        ticks.pop_back();
+    }
+};
+
+template<typename T>
+class Column : public ColumnBase {
+public:
+    std::vector<T> data;
+
+    std::unique_ptr<ColumnBase> createEmpty() const override {
+        return std::make_unique<Column<T>>();
+    }
+
+    void moveRow(size_t row, ColumnBase& other) override {
+        static_cast<Column<T>&>(other).data.push_back(std::move(data[row]));
+        moveTicks(row, other);
+        removeRow(row);
+    }
+
+    void removeRow(size_t row) override {
+        if (row + 1 != data.size()) {
+            data[row] = std::move(data.back());
+        }
+        data.pop_back();
+        removeTicks(row);
+    }
+
+    void reserve(size_t count) override {
+        data.reserve(count);
+        ticks.reserve(count);
+    }
+
+    size_t size() const override {
+        return data.size();
+    }
+};
+
+// All the entities that have exactly the same set of component types.
+// Components are stored by type (one contiguous column per type, structure of arrays),
+// and row i of every column belongs to getEntities()[i].
+class Archetype {
+public:
+    // types must be sorted (see Manager), columns given in the same order
+    Archetype(std::vector<ComponentTypeID> types, std::vector<std::unique_ptr<ColumnBase>> columns);
+
+    const std::vector<ComponentTypeID>& getTypes() const { return types; }
+    const Signature& getSignature() const { return signature; }
+    const std::vector<EntityID>& getEntities() const { return entities; }
+    size_t size() const { return entities.size(); }
+
+    // Index of the column of this type, -1 if the archetype does not have it (table lookup)
+    int getColumnIndex(ComponentTypeID type) const { return columnIndices[type]; }
+    bool hasType(ComponentTypeID type) const { return signature.test(type); }
+    // true if every type of the signature is in the archetype
+    bool hasTypes(const Signature& types) const { return (signature & types) == types; }
+
+    ColumnBase& getColumn(size_t index) { return *columns[index]; }
+    std::unique_ptr<ColumnBase> createEmptyColumn(size_t index) const { return columns[index]->createEmpty(); }
+
+    template<typename T>
+    Column<T>* getColumn() {
+        int index = columnIndices[getComponentTypeID<T>()];
+        return index >= 0 ? static_cast<Column<T>*>(columns[index].get()) : nullptr;
+    }
+
+    // Add a row for the entity: the caller then pushes exactly one component in each column
+    size_t pushEntity(EntityID entity);
+    // Remove the row (components destroyed)
+    // returns the entity moved into this row to keep the columns packed, INVALID_ENTITY if none
+    EntityID removeRow(size_t row);
+    // Move the row to the end of destination: shared components are moved, the others destroyed.
+    // The caller then pushes the components that only destination has.
+    // returns the entity moved into this row, INVALID_ENTITY if none
+    EntityID moveRow(size_t row, Archetype& destination);
+
+    void reserve(size_t count);
+    // Room for count more rows before a batch of moves (grows geometrically, like push_back)
+    void reserveExtra(size_t count);
+
+    // Archetype reached by adding / removing one component type, nullptr until Manager needs it
+    std::array<Archetype*, MAX_COMPONENT_TYPES> addEdges;
+    std::array<Archetype*, MAX_COMPONENT_TYPES> removeEdges;
+
+private:
+    EntityID popRow(size_t row);
+
+    std::vector<ComponentTypeID> types;
+    Signature signature;
+    std::array<int8_t, MAX_COMPONENT_TYPES> columnIndices;
+    std::vector<std::unique_ptr<ColumnBase>> columns;
+    std::vector<EntityID> entities;
+};
+
+#endif // ARCHETYPE_HPP
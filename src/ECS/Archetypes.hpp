@@ -4,24 +4,24 @@
 #include "Manager.hpp"
 #include "Components.hpp"
 
-EntityID createCircularObject(std::shared_ptr<Manager> manager, float x, float z, float radius, float vx, float vz, float mass, uint32_t rgba) {
+inline EntityID createCircularObject(std::shared_ptr<Manager> manager, float x, float z, float radius, float vx, float vz, float mass, uint32_t rgba) {
     EntityID entity = manager->createEntity();
-    manager->addComponent(entity, "Transform", std::make_unique<TransformComponent>(Vector3D(x,  0.0f, z), Vector3D(0.0f, 0.0f, 0.0f), Vector3D(radius, 0.0f, radius)));
-    manager->addComponent(entity, "Mobile",    std::make_unique<MobileComponent>(MobileComponent::DYNAMIC, Vector3D(vx,  0.0f, vz), Vector3D(0.0f, 0.0f, 0.0f), mass));
-    manager->addComponent(entity, "Shape",     std::make_unique<ShapeComponent>(ShapeComponent::CIRCLE));
-    manager->addComponent(entity, "Color",     std::make_unique<ColorComponent>(rgba)); // 255 for alpha
+    manager->add<TransformComponent>(entity, glm::vec3(x,  0.0f, z), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(radius, 0.0f, radius));
+    manager->add<MobileComponent>(entity, MobileComponent::DYNAMIC, glm::vec3(vx,  0.0f, vz), glm::vec3(0.0f, 0.0f, 0.0f), mass);
+    manager->add<ShapeComponent>(entity, ShapeComponent::CIRCLE);
+    manager->add<ColorComponent>(entity, rgba); // 255 for alpha
     return entity;
 }
 
-EntityID createCrateObject(std::shared_ptr<Manager> manager, float x, float z, float width, float height, uint32_t background_color, uint32_t border_color) {
+inline EntityID createCrateObject(std::shared_ptr<Manager> manager, float x, float z, float width, float height, uint32_t background_color, uint32_t border_color) {
     EntityID entity = manager->createEntity();
-    manager->addComponent(entity, "Transform", std::make_unique<TransformComponent>(Vector3D(x,  0.0f, z), Vector3D(0.0f, 0.0f, 0.0f), Vector3D(width, 0.0f, height)));
-    manager->addComponent(entity, "Mobile",    std::make_unique<MobileComponent>(MobileComponent::STATIC, Vector3D(0.0f, 0.0f, 0.0f), Vector3D(0.0f, 0.0f, 0.0f), 0.0f));
-    manager->addComponent(entity, "Shape",     std::make_unique<ShapeComponent>(ShapeComponent::CRATE));
-    manager->addComponent(entity, "Color",     std::make_unique<ColorComponent>({
+    manager->add<TransformComponent>(entity, glm::vec3(x,  0.0f, z), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(width, 0.0f, height));
+    manager->add<MobileComponent>(entity, MobileComponent::STATIC, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f), 0.0f);
+    manager->add<ShapeComponent>(entity, ShapeComponent::CRATE);
+    manager->add<ColorComponent>(entity, ColorComponent::ColorMap{
         {ColorComponent::Background, background_color},
         {ColorComponent::Border, border_color}
-    }));
+    });
     return entity;
 }
 
@@ -0,0 +1,60 @@
+#ifndef CHANGE_TICK_HPP
+#define CHANGE_TICK_HPP
+
+#include <cstdint>
+
+// Change detection: the Manager counts system phase calls with a tick, and every component row
+// remembers the tick at which it was added and last written (see Column).
+// A system phase sees as changed what was written after its call of the previous frame,
+// by anyone but itself.
+using Tick = uint32_t;
+
+struct ComponentTicks {
+    Tick added;
+    Tick changed;
+};
+
+// Ticks wrap around: two ticks can be compared while they are less than 2^31 ticks apart
+// (about a week at a few thousand system runs per second). A component that is never written
+// would fall further behind, so the Manager raises every stored tick older than MAX_TICK_AGE / 2
+// once every TICK_CHECK_INTERVAL ticks: no tick is ever more than 3/4 of the range old.
+constexpr Tick MAX_TICK_AGE = 0x7FFFFFFF;
+constexpr Tick TICK_CHECK_INTERVAL = MAX_TICK_AGE / 4;
+
+// true if tick is after since
+inline bool isNewer(Tick tick, Tick since) {
+    return static_cast<int32_t>(tick - since) > 0;
+}
+
+// Raise tick to floor if it is older
+inline void clampTick(Tick& tick, Tick floor) {
+    if (isNewer(floor, tick)) tick = floor;
+}
+
+// Ticks of the system running on the current thread (set by the Manager around each phase call)
+struct ChangeTickContext {
+    Tick thisRun;  // stamp of the writes made by the system
+    Tick lastRun;  // thisRun of the same phase in the previous frame: Changed / Added filters compare against it
+};
+
+namespace ChangeTicks {
+    // nullptr outside systems: writes are stamped with the Manager tick and filters let everything through
+    inline thread_local const ChangeTickContext* current = nullptr;
+}
+
+// Makes context current on this thread until the end of the scope
+class ChangeTickScope {
+public:
+    explicit ChangeTickScope(const ChangeTickContext* context) : previous(ChangeTicks::current) {
+        ChangeTicks::current = context;
+    }
+    ~ChangeTickScope() { ChangeTicks::current = previous; }
+
+    ChangeTickScope(const ChangeTickScope&) = delete;
+    ChangeTickScope& operator=(const ChangeTickScope&) = delete;
+
+private:
+    const ChangeTickContext* previous;
+};
+
+#endif // CHANGE_TICK_HPP
@@ -0,0 +1,13 @@
+#include "CommandBuffer.hpp"
+
+void CommandBuffer::clear() {
+    createdCount = 0;
+    adds.clear();
+    removes.clear();
+    destroys.clear();
+    for (auto& batch : values) {
+        if (batch) {
+            batch->clear();
+        }
+    }
+}
@@ -0,0 +1,115 @@
+#ifndef COMMAND_BUFFER_HPP
+#define COMMAND_BUFFER_HPP
+
+#include <vector>
+#include <array>
+#include <memory>
+#include <cstdint>
+
+#include "Entity.hpp"
+#include "ComponentType.hpp"
+#include "Archetype.hpp"
+
+// Structural changes (create / destroy entities, add / remove components) recorded while
+// systems iterate, and applied later by Manager::playback at a sync point.
+// A buffer is not thread safe: each system records into its own (see SystemBase::commands),
+// and the Manager plays them back in priority order between two phases.
+//
+// Playback order: entities are created, then components are added (the last value wins),
+// then components are removed, then entities are destroyed. Each entity is moved at most
+// once, directly to its final archetype. Commands on entities that died before the
+// playback are ignored.
+class CommandBuffer {
+public:
+    CommandBuffer() : createdCount(0) {}
+
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+    // Placeholder handle, only usable in the commands of this buffer until the playback
+    EntityID createEntity() {
+        return {EntityID::PENDING_BIT | createdCount++, 0};
+    }
+
+    void destroyEntity(EntityID entity) {
+        destroys.push_back(entity);
+    }
+
+    // Add (or replace) a component, built from args now and moved into the Manager at playback
+    template<typename T, typename... Args>
+    void add(EntityID entity, Args&&... args) {
+        const ComponentTypeID type = getComponentTypeID<T>();
+        if (!values[type]) {
+            values[type] = std::make_unique<ValueBatch<T>>();
+        }
+        auto& batch = static_cast<ValueBatch<T>&>(*values[type]).values;
+        adds.push_back({entity, type, static_cast<uint32_t>(batch.size())});
+        batch.emplace_back(std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    void remove(EntityID entity) {
+        removes.push_back({entity, getComponentTypeID<T>()});
+    }
+
+    bool empty() const {
+        return createdCount == 0 && adds.empty() && removes.empty() && destroys.empty();
+    }
+
+    // Forget every command (capacities are kept, so recording stops allocating after a few frames)
+    void clear();
+
+private:
+    friend class Manager;
+
+    // Values of the added components of one type
+    class ValueBatchBase {
+    public:
+        virtual ~ValueBatchBase() = default;
+        virtual std::unique_ptr<ColumnBase> createColumn() const = 0;
+        virtual void pushTo(ColumnBase& column, uint32_t value) = 0;
+        virtual void assignTo(ColumnBase& column, size_t row, uint32_t value) = 0;
+        virtual void clear() = 0;
+    };
+
+    template<typename T>
+    class ValueBatch : public ValueBatchBase {
+    public:
+        std::vector<T> values;
+
+        std::unique_ptr<ColumnBase> createColumn() const override {
+            return std::make_unique<Column<T>>();
+        }
+
+        void pushTo(ColumnBase& column, uint32_t value) override {
+            static_cast<Column<T>&>(column).data.push_back(std::move(values[value]));
+        }
+
+        void assignTo(ColumnBase& column, size_t row, uint32_t value) override {
+            static_cast<Column<T>&>(column).data[row] = std::move(values[value]);
+        }
+
+        void clear() override {
+            values.clear();
+        }
+    };
+
+    struct AddCommand {
+        EntityID entity;
+        ComponentTypeID type;
+        uint32_t value;  // index in the ValueBatch of type
+    };
+
+    struct RemoveCommand {
+        EntityID entity;
+        ComponentTypeID type;
+    };
+
+    uint32_t createdCount;
+    std::vector<AddCommand> adds;
+    std::vector<RemoveCommand> removes;
+    std::vector<EntityID> destroys;
+    std::array<std::unique_ptr<ValueBatchBase>, MAX_COMPONENT_TYPES> values;
+};
+
+#endif // COMMAND_BUFFER_HPP
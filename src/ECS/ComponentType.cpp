@@ -0,0 +1,16 @@
+#include "ComponentType.hpp"
+#include <atomic>
+#include "../Core/CustomException.hpp"
+
+namespace ComponentTypes {
+
+ComponentTypeID next() {
+    static std::atomic<ComponentTypeID> counter(0);
+    ComponentTypeID id = counter++;
+    if (id >= MAX_COMPONENT_TYPES) {
+        THROW_CUSTOM_EXCEPTION(Fatal, "Too many component types (MAX_COMPONENT_TYPES = " << MAX_COMPONENT_TYPES << ")");
+    }
+    return id;
+}
+
+} // namespace ComponentTypes
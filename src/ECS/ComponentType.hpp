@@ -0,0 +1,42 @@
+#ifndef COMPONENT_TYPE_HPP
+#define COMPONENT_TYPE_HPP
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Dense integer identifier of a component type, used as a column / bit index
+using ComponentTypeID = uint32_t;
+
+constexpr size_t MAX_COMPONENT_TYPES = 64;
+
+// Set of component types: one bit per ComponentTypeID
+using Signature = std::bitset<MAX_COMPONENT_TYPES>;
+
+namespace ComponentTypes {
+    // Next free identifier (thread safe), only called once per component type
+    ComponentTypeID next();
+}
+
+// Identifier of T, assigned the first time it is requested: no string and no RTTI involved.
+// Identifiers are stable for the whole run but may differ between runs.
+// const T has the identifier of T (const only marks read access, see Query.hpp)
+template<typename T>
+ComponentTypeID getComponentTypeID() {
+    if constexpr (std::is_const_v<T>) {
+        return getComponentTypeID<std::remove_const_t<T>>();
+    } else {
+        static const ComponentTypeID id = ComponentTypes::next();
+        return id;
+    }
+}
+
+template<typename... Components>
+Signature getSignature() {
+    Signature signature;
+    (signature.set(getComponentTypeID<Components>()), ...);
+    return signature;
+}
+
+#endif // COMPONENT_TYPE_HPP
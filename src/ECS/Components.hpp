@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <map>
 #include "ComponentBase.hpp"
+#include "../Core/PoolAllocator.hpp"
 #include <glm/glm.hpp>
 
 class TransformComponent : public ComponentBase {
@@ -157,6 +158,10 @@ public:
         PARALLEPIPED,
         CYLINDER,
         CONE,
+        // Formes 2D dessinées par RenderSystem
+        CIRCLE,
+        RECTANGLE,
+        CRATE,
     };
     ShapeType shape;
 
@@ -174,11 +179,15 @@ public:
         User5 = 5
     };
 
-    std::map<ColorType, uint32_t> colors;
+    // Map nodes come from a pool shared by every ColorComponent instead of one heap allocation each
+    using ColorMap = std::map<ColorType, uint32_t, std::less<ColorType>,
+                              PoolStdAllocator<std::pair<const ColorType, uint32_t>, ColorComponent>>;
 
-    ColorComponent(uint32_t rgba) : colors({ColorType::Background, rgba}) {}
+    ColorMap colors;
 
-    ColorComponent(std::map<ColorType, uint32_t> colors) : colors(colors) {}
+    ColorComponent(uint32_t rgba) : colors({{ColorType::Background, rgba}}) {}
+
+    ColorComponent(ColorMap colors) : colors(std::move(colors)) {}
 
     void getColor(uint8_t &r, uint8_t &g, uint8_t &b, uint8_t &a) {
         uint32_t rgba = colors[ColorType::Background];
@@ -1,9 +1,41 @@
-#ifndef ENTITY_HPP
-#define ENTITY_HPP
+#ifndef ECS_ENTITY_HPP
+#define ECS_ENTITY_HPP
 
 #include <iostream>
+#include <cstdint>
+#include <functional>
 
-using EntityID = size_t;
-constexpr EntityID INVALID_ENTITY = static_cast<EntityID>(-1);
+// Entity handle: slot index in the Manager + generation of the slot.
+// Deleting an entity increments the generation of its slot before the slot is reused,
+// so an old handle no longer matches and is detected as dead instead of reaching the new entity.
+struct EntityID {
+    static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+    // Set on the placeholders returned by CommandBuffer::createEntity (never on a Manager slot)
+    static constexpr uint32_t PENDING_BIT = 0x80000000;
 
-#endif // ENTITY_HPP
\ No newline at end of file
+    uint32_t index;
+    uint32_t generation;
+
+    bool isValid() const { return index != INVALID_INDEX; }
+    bool isPending() const { return isValid() && (index & PENDING_BIT) != 0; }
+
+    bool operator==(const EntityID& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const EntityID& other) const { return !(*this == other); }
+};
+
+constexpr EntityID INVALID_ENTITY = {EntityID::INVALID_INDEX, 0};
+
+inline std::ostream& operator<<(std::ostream& stream, const EntityID& entity) {
+    return stream << entity.index << "v" << entity.generation;
+}
+
+namespace std {
+template<>
+struct hash<EntityID> {
+    size_t operator()(const EntityID& entity) const {
+        return std::hash<uint64_t>()((static_cast<uint64_t>(entity.generation) << 32) | entity.index);
+    }
+};
+}
+
+#endif // ECS_ENTITY_HPP
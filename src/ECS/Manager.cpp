@@ -0,0 +1,391 @@
+#include "Manager.hpp"
+#include <stdexcept>
+
+bool compareSystems(const std::unique_ptr<SystemBase>& a, const std::unique_ptr<SystemBase>& b) {
+    return a->getPriority() < b->getPriority();
+}
+
+Manager::Manager() : aliveCount(0), changeTick(1), lastTickCheck(1) {
+    emptyArchetype = createArchetype({}, {});
+}
+
+Manager::~Manager() = default;
+
+Archetype* Manager::createArchetype(std::vector<ComponentTypeID> types, std::vector<std::unique_ptr<ColumnBase>> columns) {
+    auto archetype = std::make_unique<Archetype>(std::move(types), std::move(columns));
+    Archetype* pointer = archetype.get();
+    archetypesBySignature.emplace(pointer->getSignature(), std::move(archetype));
+    archetypes.push_back(pointer);
+    for (auto& [signature, query] : queries) {
+        query->match(pointer);
+    }
+    return pointer;
+}
+
+Archetype* Manager::getArchetypeWithout(Archetype* source, ComponentTypeID type) {
+    if (Archetype* target = source->removeEdges[type]) {
+        return target;
+    }
+
+    Signature signature = source->getSignature();
+    signature.reset(type);
+
+    Archetype* target;
+    auto it = archetypesBySignature.find(signature);
+    if (it != archetypesBySignature.end()) {
+        target = it->second.get();
+    } else {
+        std::vector<ComponentTypeID> types;
+        std::vector<std::unique_ptr<ColumnBase>> columns;
+        for (size_t i = 0; i < source->getTypes().size(); ++i) {
+            if (source->getTypes()[i] != type) {
+                types.push_back(source->getTypes()[i]);
+                columns.push_back(source->createEmptyColumn(i));
+            }
+        }
+        target = createArchetype(std::move(types), std::move(columns));
+    }
+    source->removeEdges[type] = target;
+    target->addEdges[type] = source;
+    return target;
+}
+
+Archetype* Manager::getArchetypeWith(Archetype* source, ComponentTypeID type) {
+    if (Archetype* target = source->addEdges[type]) {
+        return target;
+    }
+
+    Signature signature = source->getSignature();
+    signature.set(type);
+
+    Archetype* target;
+    auto it = archetypesBySignature.find(signature);
+    if (it != archetypesBySignature.end()) {
+        target = it->second.get();
+    } else {
+        std::vector<ComponentTypeID> types = source->getTypes();
+        types.insert(std::upper_bound(types.begin(), types.end(), type), type);
+        std::vector<std::unique_ptr<ColumnBase>> columns;
+        for (ComponentTypeID columnType : types) {
+            int index = source->getColumnIndex(columnType);
+            columns.push_back(index >= 0 ? source->createEmptyColumn(index) : columnPrototypes[columnType]->createEmpty());
+        }
+        target = createArchetype(std::move(types), std::move(columns));
+    }
+    source->addEdges[type] = target;
+    target->removeEdges[type] = source;
+    return target;
+}
+
+void Manager::relocate(EntityID moved, Archetype* archetype, size_t row) {
+    if (moved != INVALID_ENTITY) {
+        EntityRecord& record = records[moved.index];
+        record.archetype = archetype;
+        record.row = row;
+    }
+}
+
+Manager::EntityRecord& Manager::getRecord(EntityID entity) {
+    EntityRecord* record = findRecord(entity);
+    if (record == nullptr) {
+        throw std::out_of_range("Manager: dead or invalid entity");
+    }
+    return *record;
+}
+
+// Entity management
+EntityID Manager::createEntity() {
+    EntityID entity = allocateEntity();
+    records[entity.index].row = emptyArchetype->pushEntity(entity);
+    return entity;
+}
+
+EntityID Manager::allocateEntity() {
+    uint32_t index;
+    if (!freeIndices.empty()) {
+        index = freeIndices.back();
+        freeIndices.pop_back();
+    } else {
+        if (records.size() >= EntityID::PENDING_BIT) {
+            throw std::length_error("Manager: too many entities");
+        }
+        index = static_cast<uint32_t>(records.size());
+        records.push_back({nullptr, 0, 0});
+    }
+
+    EntityRecord& record = records[index];
+    record.archetype = emptyArchetype;
+    record.row = UNPLACED_ROW;
+    aliveCount++;
+    return {index, record.generation};
+}
+
+void Manager::deleteEntity(EntityID entity) {
+    EntityRecord* record = findRecord(entity);
+    if (record == nullptr) {
+        return;
+    }
+    Archetype* archetype = record->archetype;
+    size_t row = record->row;
+    record->archetype = nullptr;
+    // A slot whose generation wraps around is retired, so that no old handle can match it again
+    if (++record->generation != 0) {
+        freeIndices.push_back(entity.index);
+    }
+    aliveCount--;
+    relocate(archetype->removeRow(row), archetype, row);
+}
+
+bool Manager::isAlive(EntityID entity) const {
+    return findRecord(entity) != nullptr;
+}
+
+size_t Manager::getEntityCount() const {
+    return aliveCount;
+}
+
+// Command buffers
+namespace {
+const uint32_t NO_CHANGE = 0xFFFFFFFF;
+}
+
+Manager::PendingChange* Manager::getPendingChange(EntityID entity) {
+    if (entity.isPending()) {
+        uint32_t created = entity.index & ~EntityID::PENDING_BIT;
+        if (created >= createdEntities.size()) {
+            return nullptr;
+        }
+        entity = createdEntities[created];
+    }
+    if (findRecord(entity) == nullptr) {
+        return nullptr;
+    }
+    uint32_t& change = changeOfSlot[entity.index];
+    if (change == NO_CHANGE) {
+        change = static_cast<uint32_t>(changes.size());
+        changes.push_back({entity, Signature(), Signature(), false, nullptr});
+    }
+    return &changes[change];
+}
+
+void Manager::playback(CommandBuffer& buffer, std::vector<EntityID>* created) {
+    if (buffer.empty()) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < buffer.createdCount; ++i) {
+        createdEntities.push_back(allocateEntity());
+    }
+    changeOfSlot.resize(records.size(), NO_CHANGE);
+    for (ComponentTypeID type = 0; type < MAX_COMPONENT_TYPES; ++type) {
+        if (buffer.values[type] && !columnPrototypes[type]) {
+            columnPrototypes[type] = buffer.values[type]->createColumn();
+        }
+    }
+
+    // One change record per entity, whatever the number of commands on it
+    for (uint32_t i = 0; i < buffer.adds.size(); ++i) {
+        const CommandBuffer::AddCommand& command = buffer.adds[i];
+        if (PendingChange* change = getPendingChange(command.entity)) {
+            change->added.set(command.type);
+            pendingAdds.push_back({static_cast<uint32_t>(change - changes.data()), i});
+        }
+    }
+    for (const CommandBuffer::RemoveCommand& command : buffer.removes) {
+        if (PendingChange* change = getPendingChange(command.entity)) {
+            change->removed.set(command.type);
+        }
+    }
+    for (EntityID entity : buffer.destroys) {
+        if (PendingChange* change = getPendingChange(entity)) {
+            change->destroyed = true;
+        }
+    }
+    // Adds grouped by entity, in recording order (usually already the case)
+    auto byChange = [](const PendingAdd& a, const PendingAdd& b) { return a.change < b.change; };
+    if (!std::is_sorted(pendingAdds.begin(), pendingAdds.end(), byChange)) {
+        std::stable_sort(pendingAdds.begin(), pendingAdds.end(), byChange);
+    }
+
+    // Final archetype of each entity, found through the edges once per distinct
+    // (archetype, added, removed) transition, and counted so that every target grows once
+    for (PendingChange& change : changes) {
+        if (change.destroyed) {
+            continue;
+        }
+        Archetype* source = records[change.entity.index].archetype;
+        auto it = std::find_if(transitions.begin(), transitions.end(), [&](const Transition& transition) {
+            return transition.source == source && transition.added == change.added && transition.removed == change.removed;
+        });
+        if (it == transitions.end()) {
+            Archetype* target = source;
+            uint64_t removed = (change.removed & source->getSignature()).to_ullong();
+            uint64_t added = (change.added & ~change.removed & ~source->getSignature()).to_ullong();
+            for (; removed != 0; removed &= removed - 1) {
+                target = getArchetypeWithout(target, __builtin_ctzll(removed));
+            }
+            for (; added != 0; added &= added - 1) {
+                target = getArchetypeWith(target, __builtin_ctzll(added));
+            }
+            transitions.push_back({source, change.added, change.removed, target, 0});
+            it = transitions.end() - 1;
+        }
+        it->count++;
+        change.target = it->target;
+    }
+    for (const Transition& transition : transitions) {
+        if (transition.target != transition.source) {
+            transition.target->reserveExtra(transition.count);
+        }
+    }
+    transitions.clear();
+
+    // One move per entity, then the added components are pushed (new type) or assigned (replaced)
+    const Tick tick = getWriteTick();
+    size_t nextAdd = 0;
+    for (uint32_t i = 0; i < changes.size(); ++i) {
+        const PendingChange& change = changes[i];
+        if (change.destroyed) {
+            while (nextAdd < pendingAdds.size() && pendingAdds[nextAdd].change == i) {
+                nextAdd++;
+            }
+            continue;
+        }
+
+        EntityRecord& record = records[change.entity.index];
+        Archetype* source = record.archetype;
+        Archetype* target = change.target;
+        if (record.row == UNPLACED_ROW) {
+            record.archetype = target;
+            record.row = target->pushEntity(change.entity);
+        } else if (target != source) {
+            size_t row = target->size();
+            relocate(source->moveRow(record.row, *target), source, record.row);
+            record.archetype = target;
+            record.row = row;
+        }
+
+        Signature pushed;
+        for (; nextAdd < pendingAdds.size() && pendingAdds[nextAdd].change == i; ++nextAdd) {
+            const CommandBuffer::AddCommand& command = buffer.adds[pendingAdds[nextAdd].command];
+            int column = target->getColumnIndex(command.type);
+            if (column < 0) {
+                continue;  // removed by a later command
+            }
+            CommandBuffer::ValueBatchBase& values = *buffer.values[command.type];
+            if (source->hasType(command.type) || pushed.test(command.type)) {
+                values.assignTo(target->getColumn(column), record.row, command.value);
+                target->getColumn(column).markChanged(record.row, tick);
+            } else {
+                values.pushTo(target->getColumn(column), command.value);
+                target->getColumn(column).pushTicks(tick);
+                pushed.set(command.type);
+            }
+        }
+    }
+
+    // Created entities without components (or destroyed) end in the empty archetype
+    for (EntityID entity : createdEntities) {
+        EntityRecord& record = records[entity.index];
+        if (record.row == UNPLACED_ROW) {
+            record.row = emptyArchetype->pushEntity(entity);
+        }
+    }
+    for (const PendingChange& change : changes) {
+        changeOfSlot[change.entity.index] = NO_CHANGE;
+        if (change.destroyed) {
+            deleteEntity(change.entity);
+        }
+    }
+    if (created != nullptr) {
+        created->insert(created->end(), createdEntities.begin(), createdEntities.end());
+    }
+
+    createdEntities.clear();
+    changes.clear();
+    pendingAdds.clear();
+    buffer.clear();
+}
+
+void Manager::flushSystemCommands() {
+    for (auto& system : systems) {
+        playback(system->getCommands());
+    }
+}
+
+// System management
+void Manager::addSystem(std::unique_ptr<SystemBase> system) {
+    // First call: every existing component counts as added and changed
+    system->lastRunTicks.fill(getChangeTick() - MAX_TICK_AGE);
+    systems.push_back(std::move(system));
+    std::sort(systems.begin(), systems.end(), compareSystems);
+}
+
+void Manager::deleteSystem(SystemBase* system) {
+    systems.erase(std::remove_if(systems.begin(), systems.end(),
+        [system](const std::unique_ptr<SystemBase>& s) { return s.get() == system; }), systems.end());
+}
+
+void Manager::updateSystems(SDL_Event *event, SDL_Renderer *renderer, float deltaTime) {
+    runPhase(0, [&](SystemBase& system) { system.preUpdate(event, renderer, deltaTime); });
+    runPhase(1, [&](SystemBase& system) { system.update(event, renderer, deltaTime); });
+    runPhase(2, [&](SystemBase& system) { system.postUpdate(event, renderer, deltaTime); });
+}
+
+void Manager::runPhase(size_t phaseIndex, const std::function<void(SystemBase&)>& phase) {
+    // Each call takes the next tick: the system stamps its writes with it, and its filters see
+    // what was stamped after the same phase of the previous frame (by other systems, commands
+    // or code outside systems). Ticks of the other phases would hide the changes made in between.
+    const Tick now = changeTick.load(std::memory_order_relaxed);
+    if (now - lastTickCheck >= TICK_CHECK_INTERVAL) {
+        clampChangeTicks(now);
+    }
+
+    auto call = [this, phaseIndex, &phase](SystemBase& system) {
+        Tick& lastRun = system.lastRunTicks[phaseIndex];
+        ChangeTickContext context{changeTick.fetch_add(1, std::memory_order_relaxed), lastRun};
+        ChangeTickScope scope(&context);
+        phase(system);
+        lastRun = context.thisRun;
+    };
+
+    if (scheduler) {
+        std::vector<SystemBase*> sorted;
+        sorted.reserve(systems.size());
+        for (auto& system : systems) {
+            sorted.push_back(system.get());
+        }
+        scheduler->run(sorted, call);
+    } else {
+        for (auto& system : systems) {
+            call(*system);
+        }
+    }
+    flushSystemCommands();
+}
+
+void Manager::clampChangeTicks(Tick now) {
+    // A component untouched for that long keeps the floor tick: it is not seen as changed any more,
+    // except by a system whose previous call is as old, raised one tick lower (it sees it once more
+    // rather than missing a change)
+    const Tick floor = now - MAX_TICK_AGE / 2;
+    for (Archetype* archetype : archetypes) {
+        for (size_t column = 0; column < archetype->getTypes().size(); ++column) {
+            archetype->getColumn(column).clampTicks(floor);
+        }
+    }
+    for (auto& system : systems) {
+        for (Tick& lastRun : system->lastRunTicks) {
+            clampTick(lastRun, floor - 1);
+        }
+    }
+    lastTickCheck = now;
+}
+
+void Manager::enableParallelSystems(unsigned int threadCount) {
+    scheduler = std::make_unique<SystemScheduler>(threadCount);
+}
+
+void Manager::disableParallelSystems() {
+    scheduler.reset();
+}
@@ -4,94 +4,312 @@
 #include <iostream>
 #include <vector>
 #include <unordered_map>
+#include <tuple>
 #include <algorithm>
 #include <memory>
+#include <atomic>
+#include <functional>
 #include <SDL2/SDL.h>
 
 #include "Entity.hpp"
 #include "ComponentBase.hpp"
 #include "SystemBase.hpp"
+#include "ComponentType.hpp"
+#include "Archetype.hpp"
+#include "Query.hpp"
+#include "Scheduler.hpp"
+#include "CommandBuffer.hpp"
+#include "ChangeTick.hpp"
 
 // System comparison based on priority (lower value = higher priority)
-bool compareSystems(const std::unique_ptr<SystemBase>& a, const std::unique_ptr<SystemBase>& b) {
-    return a->getPriority() < b->getPriority();
-}
+bool compareSystems(const std::unique_ptr<SystemBase>& a, const std::unique_ptr<SystemBase>& b);
 
 // Manager class to handle entities and systems
+// Components are stored by value in archetypes: entities with the same component types share
+// one archetype where each component type is a contiguous column (see Archetype.hpp).
+// Component types are identified by getComponentTypeID<T>() and sets of types by a Signature.
+// Systems iterate cached queries (see Query.hpp), kept up to date when archetypes are created.
+// Every call of a system phase takes a new tick, which stamps the components it writes
+// (see ChangeTick.hpp), so that systems can iterate only what changed since their previous call.
 class Manager {
 private:
-    EntityID nextEntityID;
-    std::unordered_map<EntityID, std::unordered_map<std::string, std::unique_ptr<ComponentBase>>> entities;
+    // Slot of an entity: where its components are, nullptr archetype if the slot is free
+    struct EntityRecord {
+        Archetype* archetype;
+        size_t row;
+        uint32_t generation;
+    };
+
+    std::vector<EntityRecord> records;  // indexed by EntityID::index
+    std::vector<uint32_t> freeIndices;  // free slots, reused last in first out
+    size_t aliveCount;
+    std::unordered_map<Signature, std::unique_ptr<Archetype>> archetypesBySignature;
+    std::vector<Archetype*> archetypes;  // creation order, for iteration
+    Archetype* emptyArchetype;
+    std::unordered_map<Signature, std::unique_ptr<Query>> queries;
     std::vector<std::unique_ptr<SystemBase>> systems;
+    std::unique_ptr<SystemScheduler> scheduler;  // nullptr: systems run one after the other
+    // Next system call tick, and the stamp of the writes made outside systems
+    std::atomic<Tick> changeTick;
+    Tick lastTickCheck;  // changeTick at the last clampChangeTicks
+
+    // Empty column of every component type seen so far, to build archetypes without knowing T
+    std::array<std::unique_ptr<ColumnBase>, MAX_COMPONENT_TYPES> columnPrototypes;
+
+    // Playback scratch, kept between playbacks to avoid allocations
+    struct PendingChange {
+        EntityID entity;
+        Signature added;
+        Signature removed;
+        bool destroyed;
+        Archetype* target;
+    };
+    struct PendingAdd {
+        uint32_t change;
+        uint32_t command;  // index in CommandBuffer::adds
+    };
+    std::vector<EntityID> createdEntities;
+    std::vector<PendingChange> changes;
+    std::vector<PendingAdd> pendingAdds;
+    struct Transition {
+        Archetype* source;
+        Signature added;
+        Signature removed;
+        Archetype* target;
+        size_t count;  // entities making this transition
+    };
+    std::vector<Transition> transitions;
+    std::vector<uint32_t> changeOfSlot;  // by entity index, NO_CHANGE if untouched
+
+    Archetype* createArchetype(std::vector<ComponentTypeID> types, std::vector<std::unique_ptr<ColumnBase>> columns);
+    Archetype* getArchetypeWithout(Archetype* source, ComponentTypeID type);
+    // The column prototype of type must be registered
+    Archetype* getArchetypeWith(Archetype* source, ComponentTypeID type);
+
+    template<typename T>
+    Archetype* getArchetypeWith(Archetype* source);
+
+    // Change record of the entity for the current playback, nullptr if the entity is dead
+    PendingChange* getPendingChange(EntityID entity);
+    // Play back the command buffers of the systems, in priority order
+    void flushSystemCommands();
+    // Call phase (0 preUpdate, 1 update, 2 postUpdate) on every system with its change ticks,
+    // then flush the commands
+    void runPhase(size_t phaseIndex, const std::function<void(SystemBase&)>& phase);
+    // Stamp of a write made now: tick of the system running on this thread, or the Manager tick
+    Tick getWriteTick() const;
+    // Raise the component and system ticks older than now - MAX_TICK_AGE / 2, so that they stay
+    // comparable (called by runPhase every TICK_CHECK_INTERVAL ticks)
+    void clampChangeTicks(Tick now);
+
+    // Update the record of the entity that was moved into a freed row
+    void relocate(EntityID moved, Archetype* archetype, size_t row);
+
+    // New entity in the empty archetype, but without a row yet (UNPLACED_ROW): playback puts it
+    // directly in its final archetype
+    static constexpr size_t UNPLACED_ROW = static_cast<size_t>(-1);
+    EntityID allocateEntity();
+
+    // Record of a live entity, nullptr if the handle is stale or invalid
+    EntityRecord* findRecord(EntityID entity);
+    const EntityRecord* findRecord(EntityID entity) const;
+    // Same, but throws std::out_of_range
+    EntityRecord& getRecord(EntityID entity);
 
 public:
-    Manager() : nextEntityID(0) {}
+    Manager();
+    ~Manager();
+
+    Manager(const Manager&) = delete;
+    Manager& operator=(const Manager&) = delete;
 
     // Entity management
-    EntityID createEntity() {
-        EntityID id = nextEntityID++;
-        entities[id] = std::unordered_map<std::string, std::unique_ptr<ComponentBase>>();
-        return id;
-    }
+    // Handles of deleted entities stay detectable: isAlive returns false, get returns nullptr,
+    // add and remove throw std::out_of_range. Deleting a dead entity does nothing.
+    EntityID createEntity();
+    void deleteEntity(EntityID entity);
+    bool isAlive(EntityID entity) const;
+    size_t getEntityCount() const;
+    // Allocated slots (live + free): stays flat when entities are created and deleted at the same rate
+    size_t getEntitySlotCount() const { return records.size(); }
+    void reserveEntities(size_t count) { records.reserve(count); }
 
-    void deleteEntity(EntityID entity) {
-        entities.erase(entity);
-    }
+    // View on the cached query of the entities that have all the specified components,
+    // the query is created on first use. Systems keep the view instead of asking again.
+    // Terms may be const (read access) or change filters, see View.
+    template<typename... Terms>
+    View<Terms...> query();
 
-    // Retrieve entities that have all the specified components
-    std::vector<EntityID> getEntitiesWithComponents(const std::vector<std::string>& componentTypes) {
-        std::vector<EntityID> matchingEntities;
-        for (const auto& [entityID, components] : entities) {
-            bool allComponentsPresent = true;
-            for (const auto& componentType : componentTypes) {
-                if (components.find(componentType) == components.end()) {
-                    allComponentsPresent = false;
-                    break;
-                }
-            }
-            if (allComponentsPresent) {
-                matchingEntities.push_back(entityID);
-            }
-        }
-        return matchingEntities;
-    }
+    // Copy of the entities that have all the specified components (allocates, prefer query())
+    // Change filters are not applied
+    template<typename... Terms>
+    std::vector<EntityID> getEntitiesWith();
+
+    // Add (or replace) a component, built in place from args
+    template<typename T, typename... Args>
+    T& add(EntityID entity, Args&&... args);
 
     template<typename T>
-    void addComponent(EntityID entity, const std::string& componentType, std::unique_ptr<T> component) {
-        entities[entity][componentType] = std::move(component);
-    }
+    void remove(EntityID entity);
+
+    // nullptr if the entity has no component of this type
+    // Pointers are invalidated by any structural change (entity or component added / removed)
+    // get<T> marks the component as changed, get<const T> only reads it
+    template<typename T>
+    T* get(EntityID entity);
 
     template<typename T>
-    T* getComponent(EntityID entity, const std::string& componentType) {
-        auto& components = entities[entity];
-        if (components.find(componentType) != components.end()) {
-            return dynamic_cast<T*>(components[componentType].get());
+    bool has(EntityID entity) const;
+
+    // Apply the commands of the buffer in one batch, then clear it (see CommandBuffer.hpp)
+    // created, if given, receives the entities created by the buffer, in the order of the placeholders
+    void playback(CommandBuffer& buffer, std::vector<EntityID>* created = nullptr);
+
+    // Call function(EntityID, Terms&...) for every entity that has all the components
+    // (shortcut for query<Terms...>().forEach(function))
+    template<typename... Terms, typename Function>
+    void forEach(Function&& function);
+
+    // Tick of the next system call: a system that is not called every frame can remember it,
+    // everything written after that has a newer tick (for up to MAX_TICK_AGE / 2 ticks, see clampChangeTicks)
+    Tick getChangeTick() const { return changeTick.load(std::memory_order_relaxed); }
+
+    const std::vector<Archetype*>& getArchetypes() const { return archetypes; }
+
+    // System management
+    void addSystem(std::unique_ptr<SystemBase> system);
+    void deleteSystem(SystemBase* system);
+    // preUpdate of every system, then update, then postUpdate, in priority order
+    // (or concurrently when they do not conflict, once parallel systems are enabled).
+    // The command buffers of the systems are played back after each of the three phases.
+    void updateSystems(SDL_Event *event, SDL_Renderer *renderer, float deltaTime);
+
+    // Run the systems on a worker pool (threadCount = 0: number of cores - 1)
+    void enableParallelSystems(unsigned int threadCount = 0);
+    void disableParallelSystems();
+    bool hasParallelSystems() const { return scheduler != nullptr; }
+};
+
+/* - - - - - - - - - - - - - - - - - - - - */
+
+template<typename T>
+Archetype* Manager::getArchetypeWith(Archetype* source) {
+    const ComponentTypeID type = getComponentTypeID<T>();
+    if (Archetype* target = source->addEdges[type]) {
+        return target;
+    }
+    if (!columnPrototypes[type]) {
+        columnPrototypes[type] = std::make_unique<Column<T>>();
+    }
+    return getArchetypeWith(source, type);
+}
+
+template<typename... Terms>
+View<Terms...> Manager::query() {
+    const Signature signature = getSignature<TermComponent<Terms>...>();
+    auto it = queries.find(signature);
+    if (it == queries.end()) {
+        auto query = std::make_unique<Query>(signature, &changeTick);
+        for (Archetype* archetype : archetypes) {
+            query->match(archetype);
         }
-        return nullptr;
+        it = queries.emplace(signature, std::move(query)).first;
     }
+    return View<Terms...>(it->second.get());
+}
 
-    // System management
-    void addSystem(std::unique_ptr<SystemBase> system) {
-        systems.push_back(std::move(system));
-        std::sort(systems.begin(), systems.end(), compareSystems);
+template<typename... Terms>
+std::vector<EntityID> Manager::getEntitiesWith() {
+    const Query& matching = query<Terms...>().getQuery();
+    std::vector<EntityID> matchingEntities;
+    matchingEntities.reserve(matching.size());
+    matching.forEachEntity([&matchingEntities](EntityID entity) {
+        matchingEntities.push_back(entity);
+    });
+    return matchingEntities;
+}
+
+template<typename T, typename... Args>
+T& Manager::add(EntityID entity, Args&&... args) {
+    EntityRecord& record = getRecord(entity);
+    if (Column<T>* column = record.archetype->getColumn<T>()) {
+        T& component = column->data[record.row];
+        component = T(std::forward<Args>(args)...);
+        column->markChanged(record.row, getWriteTick());
+        return component;
     }
 
-    void deleteSystem(SystemBase* system) {
-        systems.erase(std::remove_if(systems.begin(), systems.end(),
-            [system](const std::unique_ptr<SystemBase>& s) { return s.get() == system; }), systems.end());
+    Archetype* source = record.archetype;
+    Archetype* target = getArchetypeWith<T>(source);
+    size_t row = target->size();
+    EntityID moved = source->moveRow(record.row, *target);
+    relocate(moved, source, record.row);
+    record.archetype = target;
+    record.row = row;
+
+    Column<T>* column = target->getColumn<T>();
+    column->data.emplace_back(std::forward<Args>(args)...);
+    column->pushTicks(getWriteTick());
+    return column->data.back();
+}
+
+template<typename T>
+void Manager::remove(EntityID entity) {
+    EntityRecord& record = getRecord(entity);
+    Archetype* source = record.archetype;
+    if (!source->hasType(getComponentTypeID<T>())) {
+        return;
     }
+    Archetype* target = getArchetypeWithout(source, getComponentTypeID<T>());
+    size_t row = target->size();
+    EntityID moved = source->moveRow(record.row, *target);
+    relocate(moved, source, record.row);
+    record.archetype = target;
+    record.row = row;
+}
 
-    void updateSystems(SDL_Event *event, SDL_Renderer *renderer, float deltaTime) {
-        for (auto& system : systems) {
-            system->preUpdate(event, renderer, deltaTime);
-        }
-        for (auto& system : systems) {
-            system->update(event, renderer, deltaTime);
-        }
-        for (auto& system : systems) {
-            system->postUpdate(event, renderer, deltaTime);
-        }
+inline Manager::EntityRecord* Manager::findRecord(EntityID entity) {
+    if (entity.index >= records.size()) {
+        return nullptr;
     }
-};
+    EntityRecord& record = records[entity.index];
+    return record.archetype != nullptr && record.generation == entity.generation ? &record : nullptr;
+}
+
+inline const Manager::EntityRecord* Manager::findRecord(EntityID entity) const {
+    return const_cast<Manager*>(this)->findRecord(entity);
+}
+
+template<typename T>
+T* Manager::get(EntityID entity) {
+    EntityRecord* record = findRecord(entity);
+    if (record == nullptr) {
+        return nullptr;
+    }
+    Column<std::remove_const_t<T>>* column = record->archetype->getColumn<std::remove_const_t<T>>();
+    if (column == nullptr) {
+        return nullptr;
+    }
+    if constexpr (!std::is_const_v<T>) {
+        column->markChanged(record->row, getWriteTick());
+    }
+    return &column->data[record->row];
+}
+
+template<typename T>
+bool Manager::has(EntityID entity) const {
+    const EntityRecord* record = findRecord(entity);
+    return record != nullptr && record->archetype->hasType(getComponentTypeID<T>());
+}
+
+template<typename... Terms, typename Function>
+void Manager::forEach(Function&& function) {
+    query<Terms...>().forEach(std::forward<Function>(function));
+}
+
+inline Tick Manager::getWriteTick() const {
+    const ChangeTickContext* context = ChangeTicks::current;
+    return context ? context->thisRun : changeTick.load(std::memory_order_relaxed);
+}
 
 #endif // MANAGER_HPP
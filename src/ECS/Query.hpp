@@ -0,0 +1,178 @@
+#ifndef QUERY_HPP
+#define QUERY_HPP
+
+#include <vector>
+#include <tuple>
+#include <atomic>
+#include <utility>
+#include <type_traits>
+
+#include "Entity.hpp"
+#include "ComponentType.hpp"
+#include "Archetype.hpp"
+#include "ChangeTick.hpp"
+
+// Persistent list of the archetypes that have every component of a signature.
+// Queries are owned by the Manager (see Manager::query): the signature is tested once per
+// archetype, when the query is registered and then each time the Manager creates an archetype.
+// Adding or removing a component only moves the entity between archetypes that are already
+// listed (or not), so iterating a query never scans unrelated entities and never allocates.
+class Query {
+public:
+    // worldTick: tick of the Manager, stamps the writes made outside systems
+    Query(const Signature& signature, const std::atomic<Tick>* worldTick) : signature(signature), worldTick(worldTick) {}
+
+    const Signature& getSignature() const { return signature; }
+    Tick getWorldTick() const { return worldTick->load(std::memory_order_relaxed); }
+    const std::vector<Archetype*>& getArchetypes() const { return archetypes; }
+
+    // Called by the Manager for every archetype, existing or new
+    void match(Archetype* archetype) {
+        if (archetype->hasTypes(signature)) {
+            archetypes.push_back(archetype);
+        }
+    }
+
+    // Number of matching entities (sum over the matching archetypes)
+    size_t size() const {
+        size_t count = 0;
+        for (const Archetype* archetype : archetypes) {
+            count += archetype->size();
+        }
+        return count;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    // Call function(EntityID) for every matching entity
+    template<typename Function>
+    void forEachEntity(Function&& function) const {
+        for (const Archetype* archetype : archetypes) {
+            for (EntityID entity : archetype->getEntities()) {
+                function(entity);
+            }
+        }
+    }
+
+private:
+    Signature signature;
+    const std::atomic<Tick>* worldTick;
+    std::vector<Archetype*> archetypes;
+};
+
+// Change filters, used in place of a component type in query<...>():
+// Changed<T> keeps the entities whose T was written since the previous call of the system phase
+// (an added component counts as written), Added<T> the entities that received T since then.
+// Outside systems, every entity passes.
+template<typename T>
+struct Changed {};
+
+template<typename T>
+struct Added {};
+
+// What a query term gives to the function (T&, or const T& for read access) and how it filters
+template<typename Term>
+struct QueryTerm {
+    using Type = Term;
+    static constexpr bool filtered = false;
+    static bool passes(const ComponentTicks&, Tick) { return true; }
+    static bool passes(const ColumnBase&, Tick) { return true; }
+};
+
+template<typename T>
+struct QueryTerm<Changed<T>> {
+    using Type = T;
+    static constexpr bool filtered = true;
+    static bool passes(const ComponentTicks& ticks, Tick lastRun) { return isNewer(ticks.changed, lastRun); }
+    static bool passes(const ColumnBase& column, Tick lastRun) { return isNewer(column.changedTick, lastRun); }
+};
+
+template<typename T>
+struct QueryTerm<Added<T>> {
+    using Type = T;
+    static constexpr bool filtered = true;
+    static bool passes(const ComponentTicks& ticks, Tick lastRun) { return isNewer(ticks.added, lastRun); }
+    static bool passes(const ColumnBase& column, Tick lastRun) { return isNewer(column.addedTick, lastRun); }
+};
+
+// Stored component type of a query term (no filter, no const)
+template<typename Term>
+using TermComponent = std::remove_const_t<typename QueryTerm<Term>::Type>;
+
+// Typed handle on a cached Query: a pointer, cheap to copy and to keep in a system.
+// Valid as long as the Manager that returned it.
+//
+// Terms are component types (T or const T) or change filters (Changed<T>, Added<T>).
+// A non-const term is write access: every entity the function receives is marked as changed
+// for that component, so systems that only read a component should ask for const T.
+template<typename... Terms>
+class View {
+public:
+    View() : query(nullptr) {}
+    explicit View(const Query* query) : query(query) {}
+
+    const Query& getQuery() const { return *query; }
+    // Entities matching the component types (filters not applied)
+    size_t size() const { return query->size(); }
+    bool empty() const { return query->empty(); }
+
+    // Call function(EntityID, Terms&...) for every matching entity that passes the filters,
+    // archetype by archetype, reading each column linearly
+    template<typename Function>
+    void forEach(Function&& function) const {
+        const ChangeTickContext* context = ChangeTicks::current;
+        const Tick thisRun = context ? context->thisRun : query->getWorldTick();
+        // Outside systems, compare with the oldest comparable tick: every entity passes
+        const Tick lastRun = context ? context->lastRun : thisRun - MAX_TICK_AGE;
+        forEach(function, lastRun, thisRun, std::index_sequence_for<Terms...>());
+    }
+
+private:
+    template<typename Function, size_t... I>
+    void forEach(Function& function, Tick lastRun, Tick thisRun, std::index_sequence<I...>) const {
+        for (Archetype* archetype : query->getArchetypes()) {
+            if (archetype->size() == 0) {
+                continue;
+            }
+            const std::tuple<Column<TermComponent<Terms>>*...> columns(archetype->getColumn<TermComponent<Terms>>()...);
+            if (!(QueryTerm<Terms>::passes(static_cast<const ColumnBase&>(*std::get<I>(columns)), lastRun) && ...)) {
+                continue;
+            }
+            const std::vector<EntityID>& ids = archetype->getEntities();
+            const auto data = std::make_tuple(std::get<I>(columns)->data.data()...);
+            const auto ticks = std::make_tuple(std::get<I>(columns)->ticks.data()...);
+            bool visited = false;
+            for (size_t row = 0; row < ids.size(); ++row) {
+                if constexpr ((QueryTerm<Terms>::filtered || ...)) {
+                    if (!(QueryTerm<Terms>::passes(std::get<I>(ticks)[row], lastRun) && ...)) {
+                        continue;
+                    }
+                }
+                (markWritten<Terms>(std::get<I>(ticks)[row], thisRun), ...);
+                visited = true;
+                function(ids[row], static_cast<typename QueryTerm<Terms>::Type&>(std::get<I>(data)[row])...);
+            }
+            if (visited) {
+                (touchWritten<Terms>(*std::get<I>(columns), thisRun), ...);
+            }
+        }
+    }
+
+    template<typename Term>
+    static void markWritten(ComponentTicks& ticks, Tick thisRun) {
+        if constexpr (!std::is_const_v<typename QueryTerm<Term>::Type>) {
+            ticks.changed = thisRun;
+        }
+    }
+
+    template<typename Term>
+    static void touchWritten(ColumnBase& column, Tick thisRun) {
+        if constexpr (!std::is_const_v<typename QueryTerm<Term>::Type>) {
+            column.touchChanged(thisRun);
+        }
+    }
+
+    const Query* query;
+};
+
+#endif // QUERY_HPP
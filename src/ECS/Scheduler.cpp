@@ -0,0 +1,85 @@
+#include "Scheduler.hpp"
+
+SystemScheduler::SystemScheduler(unsigned int threadCount)
+    : currentSystems(nullptr), currentPhase(nullptr), remaining(0), pool(threadCount) {}
+
+void SystemScheduler::buildGraph(const std::vector<SystemBase*>& systems) {
+    nodes.assign(systems.size(), Node{{}, 0});
+    for (size_t j = 0; j < systems.size(); ++j) {
+        for (size_t i = 0; i < j; ++i) {
+            if (systems[i]->conflictsWith(*systems[j])) {
+                nodes[i].dependents.push_back(j);
+                nodes[j].pendingDependencies++;
+            }
+        }
+    }
+}
+
+void SystemScheduler::dispatch(size_t index) {
+    if ((*currentSystems)[index]->isMainThreadOnly()) {
+        mainThreadQueue.push_back(index);
+        condition.notify_all();
+    } else {
+        pool.submit([this, index] { execute(index); });
+    }
+}
+
+void SystemScheduler::execute(size_t index) {
+    std::exception_ptr exception;
+    try {
+        (*currentPhase)(*(*currentSystems)[index]);
+    } catch (...) {
+        exception = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (exception && !error) {
+        error = exception;
+    }
+    for (size_t dependent : nodes[index].dependents) {
+        if (--nodes[dependent].pendingDependencies == 0) {
+            dispatch(dependent);
+        }
+    }
+    if (--remaining == 0) {
+        condition.notify_all();
+    }
+}
+
+void SystemScheduler::run(const std::vector<SystemBase*>& systems, const std::function<void(SystemBase&)>& phase) {
+    if (systems.empty()) {
+        return;
+    }
+    buildGraph(systems);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    currentSystems = &systems;
+    currentPhase = &phase;
+    remaining = systems.size();
+    for (size_t i = 0; i < systems.size(); ++i) {
+        if (nodes[i].pendingDependencies == 0) {
+            dispatch(i);
+        }
+    }
+
+    // Run the main thread systems as they become ready, until every system is done
+    while (true) {
+        condition.wait(lock, [this] { return remaining == 0 || !mainThreadQueue.empty(); });
+        if (remaining == 0) {
+            break;
+        }
+        size_t index = mainThreadQueue.front();
+        mainThreadQueue.pop_front();
+        lock.unlock();
+        execute(index);
+        lock.lock();
+    }
+
+    currentSystems = nullptr;
+    currentPhase = nullptr;
+    if (error) {
+        std::exception_ptr exception = error;
+        error = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
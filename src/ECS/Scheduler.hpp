@@ -0,0 +1,60 @@
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+#include "SystemBase.hpp"
+#include "../Core/ThreadPool.hpp"
+
+// Runs one phase (preUpdate, update or postUpdate) of a list of systems on a worker pool.
+// For each phase a dependency graph is built from the declared accesses: when two systems
+// conflict (see SystemBase::conflictsWith), the one with the lower priority value runs first,
+// exactly as in the serial loop. Systems that do not conflict run at the same time.
+// The calling thread waits for the phase to end and runs the main thread systems itself.
+//
+// Systems must not create or delete entities, nor add or remove components, during a
+// parallel phase: archetypes and queries are shared by every system.
+class SystemScheduler {
+public:
+    // threadCount = 0: number of cores - 1 (see ThreadPool)
+    explicit SystemScheduler(unsigned int threadCount = 0);
+
+    SystemScheduler(const SystemScheduler&) = delete;
+    SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+    // systems sorted by priority; returns when phase has been called on all of them.
+    // An exception thrown by a system is rethrown here once the phase is over.
+    void run(const std::vector<SystemBase*>& systems, const std::function<void(SystemBase&)>& phase);
+
+    unsigned int getThreadCount() const { return pool.getThreadCount(); }
+
+private:
+    struct Node {
+        std::vector<size_t> dependents;  // systems that wait for this one
+        size_t pendingDependencies;
+    };
+
+    void buildGraph(const std::vector<SystemBase*>& systems);
+    // Hand a system whose dependencies are done to the pool or to the calling thread (lock held)
+    void dispatch(size_t index);
+    void execute(size_t index);
+
+    std::vector<Node> nodes;
+    const std::vector<SystemBase*>* currentSystems;
+    const std::function<void(SystemBase&)>* currentPhase;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<size_t> mainThreadQueue;
+    size_t remaining;
+    std::exception_ptr error;
+
+    ThreadPool pool;  // destroyed first: the workers are stopped before the state above
+};
+
+#endif // SCHEDULER_HPP
@@ -6,25 +6,70 @@
 #include <unordered_map>
 #include <algorithm>
 #include <memory>
+#include <array>
 #include <SDL2/SDL.h>
 
+#include "ComponentType.hpp"
+#include "CommandBuffer.hpp"
+#include "ChangeTick.hpp"
+
 class Manager;
 
 // Base class for Systems
+// A system declares the component types it reads and writes so that the scheduler can run
+// systems that do not conflict at the same time (see SystemScheduler). A system that declares
+// nothing is treated as touching everything, and runs alone.
 class SystemBase {
 protected:
     int priority;
     std::shared_ptr<Manager> manager;
 
+    // Access declarations, to call from the constructor of the system
+    template<typename... Components>
+    void reads() { readSet |= getSignature<Components...>(); accessDeclared = true; }
+
+    template<typename... Components>
+    void writes() { writeSet |= getSignature<Components...>(); accessDeclared = true; }
+
+    // The system uses the SDL renderer (or anything else bound to the main thread)
+    void runOnMainThread() { mainThread = true; }
+
+    // Structural changes made while iterating, applied by the Manager after the current phase.
+    // Required when the systems run in parallel.
+    CommandBuffer commands;
+
 public:
     SystemBase(std::shared_ptr<Manager> manager, int p) : priority(p), manager(manager) {}
     virtual ~SystemBase() = default;
 
     int getPriority() const { return priority; }
 
+    const Signature& getReads() const { return readSet; }
+    const Signature& getWrites() const { return writeSet; }
+    bool hasDeclaredAccess() const { return accessDeclared; }
+    bool isMainThreadOnly() const { return mainThread; }
+    CommandBuffer& getCommands() { return commands; }
+
+    // true if the two systems cannot run at the same time: one writes what the other reads or writes
+    bool conflictsWith(const SystemBase& other) const {
+        if (!accessDeclared || !other.accessDeclared) {
+            return true;
+        }
+        return (writeSet & (other.readSet | other.writeSet)).any() || (other.writeSet & readSet).any();
+    }
+
     virtual void preUpdate(SDL_Event *event, SDL_Renderer *renderer, float deltaTime) = 0;
     virtual void update(SDL_Event *event, SDL_Renderer *renderer, float deltaTime) = 0;
     virtual void postUpdate(SDL_Event *event, SDL_Renderer *renderer, float deltaTime) = 0;
+
+private:
+    friend class Manager;
+
+    Signature readSet;
+    Signature writeSet;
+    bool accessDeclared = false;
+    bool mainThread = false;
+    std::array<Tick, 3> lastRunTicks{};  // tick of the previous call of each phase, set by the Manager
 };
 
 #endif // SYSTEM_BASE_HPP
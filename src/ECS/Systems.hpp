@@ -5,6 +5,7 @@
 #include "Components.hpp"
 #include "SystemBase.hpp"
 #include <memory>
+#include <vector>
 #include <glm/glm.hpp>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL2_gfxPrimitives.h>
@@ -12,12 +13,27 @@
 class PhysicsSystem : public SystemBase {
 private:
     glm::vec3 gravity;
-    Sphere earth;
+    glm::vec3 earth_position;
+    glm::vec3 earth_scale;
+    glm::vec3 earth_rotation;
+
+    // Components of one entity, gathered once per frame for the collision pairs
+    struct Body {
+        TransformComponent* transform;
+        MobileComponent* mobile;
+        const ShapeComponent* shape;
+    };
+    std::vector<Body> bodies;
+    View<TransformComponent, MobileComponent, const ShapeComponent> bodiesView;
 
 public:
     PhysicsSystem(std::shared_ptr<Manager> manager, int priority, glm::vec3 gravity = glm::vec3(0.0f, -9.81f, 0.0f),
         glm::vec3 earth_position = glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3 earth_scale = glm::vec3(1.0f, 1.0f, 1.0f), glm::vec3 earth_rotation = glm::vec3(0.0f, 0.0f, 0.0f))
-        : SystemBase(manager, priority), gravity(gravity), earth_position(earth_position), earth_scale(earth_scale), earth_rotation(earth_rotation) {}
+        : SystemBase(manager, priority), gravity(gravity), earth_position(earth_position), earth_scale(earth_scale), earth_rotation(earth_rotation),
+          bodiesView(manager->query<TransformComponent, MobileComponent, const ShapeComponent>()) {
+        reads<ShapeComponent>();
+        writes<TransformComponent, MobileComponent>();
+    }
 
     void preUpdate(SDL_Event *event, SDL_Renderer *renderer, float deltaTime) override {
         // No preparation needed before physics update
@@ -25,12 +41,10 @@ public:
 
     void update(SDL_Event *event, SDL_Renderer *renderer, float deltaTime) override {
         // Loop through entities and move them based on velocity
-        for (auto& entity : manager->getEntitiesWithComponents({"Transform", "Mobile", "Shape"})) {
-            TransformComponent* transform = manager->getComponent<TransformComponent>(entity, "Transform");
-            MobileComponent* mobile = manager->getComponent<MobileComponent>(entity, "Mobile");
-            ShapeComponent* shape = manager->getComponent<ShapeComponent>(entity, "Shape");
-
-            if (!transform || !mobile || !shape || (mobile->mobileType == MobileComponent::MobileType::STATIC)) continue;
+        bodies.clear();
+        bodiesView.forEach([this, deltaTime](EntityID, TransformComponent& transform, MobileComponent& mobile, const ShapeComponent& shape) {
+            bodies.push_back({&transform, &mobile, &shape});
+            if (mobile.mobileType == MobileComponent::MobileType::STATIC) return;
 
             // Update position based on velocity
             // Modification de l'accélération pour inclure la gravité
@@ -38,18 +52,17 @@ public:
             // Calcul de la vélocité en fonction de l'accélération et du temps de la frame
 
             // calcul de la position en fonction du temps de la frame
-            transform->position += mobile->velocity * deltaTime;
+            transform.position += mobile.velocity * deltaTime;
 
             // Résolution de la collision avec la Terre
-            resolveCollisionWithPlane(transform->position);
-            
-        }
-
-        // Check and resolve collisions between entities
-        for (auto& entityA : manager->getEntitiesWithComponents({"Transform", "Mobile", "Shape"})) {
-            for (auto& entityB : manager->getEntitiesWithComponents({"Transform", "Mobile", "Shape"})) {
-                if (entityA == entityB) continue;
-                resolveEntityCollision(entityA, entityB);
+            resolveCollisionWithPlane(transform.position);
+        });
+
+        // Check and resolve collisions between entities (no component lookup inside the pair loop)
+        for (size_t a = 0; a < bodies.size(); ++a) {
+            for (size_t b = 0; b < bodies.size(); ++b) {
+                if (a == b) continue;
+                resolveEntityCollision(bodies[a], bodies[b]);
             }
         }
     }
@@ -60,16 +73,21 @@ public:
 
 private:
 
-    void resolveEntityCollision(EntityID entityA, EntityID entityB) {
-        TransformComponent* transformA = manager->getComponent<TransformComponent>(entityA, "Transform");
-        MobileComponent* mobileA = manager->getComponent<MobileComponent>(entityA, "Mobile");
-        ShapeComponent* shapeA = manager->getComponent<ShapeComponent>(entityA, "Shape");
+    // Le sol est le plan horizontal passant par earth_position
+    void resolveCollisionWithPlane(glm::vec3& position) {
+        if (position.y < earth_position.y) {
+            position.y = earth_position.y;
+        }
+    }
 
-        TransformComponent* transformB = manager->getComponent<TransformComponent>(entityB, "Transform");
-        MobileComponent* mobileB = manager->getComponent<MobileComponent>(entityB, "Mobile");
-        ShapeComponent* shapeB = manager->getComponent<ShapeComponent>(entityB, "Shape");
+    void resolveEntityCollision(const Body& bodyA, const Body& bodyB) {
+        TransformComponent* transformA = bodyA.transform;
+        MobileComponent* mobileA = bodyA.mobile;
+        const ShapeComponent* shapeA = bodyA.shape;
 
-        if (!transformA || !mobileA || !shapeA || !transformB || !mobileB || !shapeB) return;
+        TransformComponent* transformB = bodyB.transform;
+        MobileComponent* mobileB = bodyB.mobile;
+        const ShapeComponent* shapeB = bodyB.shape;
 
         // Handle collision between a static and a dynamic object
         if (shapeA->shape == ShapeComponent::ShapeType::SPHERE && shapeB->shape == ShapeComponent::ShapeType::SPHERE) {
@@ -128,10 +146,10 @@ private:
             posA.y < posB.y + sizeB.y && posA.y + sizeA.y > posB.y) {
             
             // Collision détectée, inverser les vélocités
-            mobileA->velocity.x() = -mobileA->velocity.x();
-            mobileA->velocity.y() = -mobileA->velocity.y();
-            mobileB->velocity.x() = -mobileB->velocity.x();
-            mobileB->velocity.y() = -mobileB->velocity.y();
+            mobileA->velocity.x = -mobileA->velocity.x;
+            mobileA->velocity.y = -mobileA->velocity.y;
+            mobileB->velocity.x = -mobileB->velocity.x;
+            mobileB->velocity.y = -mobileB->velocity.y;
 
             // Séparer les rectangles
             float overlapX = (sizeA.x + sizeB.x) - std::abs(posA.x - posB.x);
@@ -194,7 +212,12 @@ static uint32_t setRGBA(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
 
 class RenderSystem : public SystemBase {
 public:
-    RenderSystem(std::shared_ptr<Manager> manager, int p, uint32_t bgColor = 0) : SystemBase(manager, p), _bgColor(bgColor) {}
+    RenderSystem(std::shared_ptr<Manager> manager, int p, uint32_t bgColor = 0)
+        : SystemBase(manager, p), _bgColor(bgColor), _drawables(manager->query<const TransformComponent, ColorComponent, const ShapeComponent>()) {
+        reads<TransformComponent, ShapeComponent>();
+        writes<ColorComponent>();  // ColorComponent::getColor uses operator[], which may insert
+        runOnMainThread();
+    }
 
     void setBackgroundColor(uint32_t rgba) { _bgColor = rgba; }
 
@@ -208,36 +231,31 @@ public:
 
     void update(SDL_Event *event, SDL_Renderer *renderer, float deltaTime) override {
         // Render entities that have Transform, Color, and Shape components
-        for (const auto& entity : manager->getEntitiesWithComponents({"Transform", "Color", "Shape"})) {
-            TransformComponent* transform = manager->getComponent<TransformComponent>(entity, "Transform");
-            ColorComponent* color = manager->getComponent<ColorComponent>(entity, "Color");
-            ShapeComponent* shape = manager->getComponent<ShapeComponent>(entity, "Shape");
+        _drawables.forEach([renderer](EntityID, const TransformComponent& transform, ColorComponent& colorComponent, const ShapeComponent& shape) {
+            ColorComponent* color = &colorComponent;
+            glm::vec3 pos = transform.getPosition();
+            glm::vec3 size = transform.getScale();
 
-            if (!transform || !color || !shape) continue;
-            glm::vec3 pos = transform->getPosition();
-            glm::vec3 rot = transform->getRotation();
-            glm::vec3 size = transform->getScale();
-
-            switch (shape->shape) {
+            switch (shape.shape) {
                 case ShapeComponent::CIRCLE:
-                    filledSphereColor(renderer, pos.x(), pos.z(), size.x(), color->getColor());
+                    filledCircleColor(renderer, pos.x, pos.z, size.x, color->getColor());
                     break;
                 case ShapeComponent::RECTANGLE:
-                    boxColor(renderer, pos.x(), pos.z(), pos.x()+size.x()-1, pos.z()+size.z()-1, color->getColor());
+                    boxColor(renderer, pos.x, pos.z, pos.x+size.x-1, pos.z+size.z-1, color->getColor());
                     break;
                 case ShapeComponent::CRATE:
-                    boxColor(renderer, pos.x(), pos.z(), pos.x()+size.x()-1, pos.z()+size.z()-1, color->getColor(ColorComponent::Background));
-                    boxColor(renderer, pos.x(), pos.z(), pos.x()+size.x()-1, pos.z()+4, color->getColor(ColorComponent::Background));
-                    boxColor(renderer, pos.x(), pos.z()+size.z()-5, pos.x()+size.x()-1, pos.z()+size.z()-1, color->getColor(ColorComponent::Background));
-                    boxColor(renderer, pos.x(), pos.z()+4, pos.x()+4, pos.z()+size.z()-5, color->getColor(ColorComponent::Background));
-                    boxColor(renderer, pos.x()+size.x()-5, pos.z()+4, pos.x()+size.x()-1, pos.z()+size.z()-5, color->getColor(ColorComponent::Background));
+                    boxColor(renderer, pos.x, pos.z, pos.x+size.x-1, pos.z+size.z-1, color->getColor(ColorComponent::Background));
+                    boxColor(renderer, pos.x, pos.z, pos.x+size.x-1, pos.z+4, color->getColor(ColorComponent::Background));
+                    boxColor(renderer, pos.x, pos.z+size.z-5, pos.x+size.x-1, pos.z+size.z-1, color->getColor(ColorComponent::Background));
+                    boxColor(renderer, pos.x, pos.z+4, pos.x+4, pos.z+size.z-5, color->getColor(ColorComponent::Background));
+                    boxColor(renderer, pos.x+size.x-5, pos.z+4, pos.x+size.x-1, pos.z+size.z-5, color->getColor(ColorComponent::Background));
                     break;
                 default:
                     break;
             }
             // Render a filled circle
             //filledSphereColor(renderer, pos, color->getRGBA());
-        }
+        });
     }
 
     void postUpdate(SDL_Event *event, SDL_Renderer *renderer, float deltaTime) override {
@@ -247,6 +265,7 @@ public:
 
 private:
     uint32_t _bgColor;
+    View<const TransformComponent, ColorComponent, const ShapeComponent> _drawables;
 };
 
 #endif // SYSTEMS_HPP
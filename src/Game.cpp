@@ -3,6 +3,7 @@
 
 #include "Core/Logger.hpp"
 #include "Core/Color.hpp"
+#include "Core/PoolAllocator.hpp"
 
 #include "Render3D/Entities/Object.hpp"
 #include "Render3D/Entities/Cube.hpp"
@@ -139,7 +140,9 @@ bool Game::initOpenGL() {
 	glEnable(GL_DEPTH_TEST);
 	// Configurer le test de profondeur pour utiliser le tampon de profondeur
 	glDepthFunc(GL_LESS);
+	// Activer la transparence (Texture::use ne le refait plus à chaque liaison)
 	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	return true;
 }
@@ -246,23 +249,32 @@ bool Game::load() {
 		directionalLight->setEnabled(true);
 		_scene3D->addLight(directionalLight);*/
 
+		// Types de blocs du monde voxel
+		auto registry = std::make_shared<Voxel::BlockRegistry>();
+		Voxel::BlockID concrete = registry->registerBlock("concrete", textures_block1);
+		Voxel::BlockID bricks   = registry->registerBlock("bricks_wall", textures_block2);
+		Voxel::BlockID wood     = registry->registerBlock("wood_planks", textures_block3);
+		Voxel::BlockID stone    = registry->registerBlock("satin_stone_red_hard", textures_block4);
+
+		_world = std::make_shared<Voxel::World>(registry);
+
 		// générer un plateau de blocks
 		int plateauWidth = 40;
 		int plateauHeight = 40;
 		
 		for (int x = -plateauWidth/2; x < plateauWidth/2; x++) {
 			for (int z = -plateauHeight/2; z < plateauHeight/2; z++) {
-				std::shared_ptr<Object> block = std::make_shared<Cube>(glm::vec3(x, 0, z), textures_block4);
+				Voxel::BlockID block;
 				if (x % 2 == 0) {
-					block->setFacesTextures(textures_block1);
+					block = concrete;
 				} else if (x % 3 == 0) {
-					block->setFacesTextures(textures_block2);
+					block = bricks;
 				} else if (x % 4 == 0) {
-					block->setFacesTextures(textures_block3);
+					block = wood;
 				} else {
-					block->setFacesTextures(textures_block4);
+					block = stone;
 				}
-				_scene3D->addEntity(block);
+				_world->setBlock(x, 0, z, block);
 			}
 		}
 
@@ -278,48 +290,54 @@ bool Game::load() {
 			z = wallZ + k;
 			for (int i = 1; i<wallWidth-1; i++) {
 				x = wallX + i;
-				std::shared_ptr<Object> wall_block1 = std::make_shared<Cube>(glm::vec3(x, z, wallY), textures_block2);
-				_scene3D->addEntity(wall_block1);
-				std::shared_ptr<Object> wall_block2 = std::make_shared<Cube>(glm::vec3(x, z, wallY+wallHeight-1), textures_block2);
-				_scene3D->addEntity(wall_block2);
+				_world->setBlock(x, z, wallY, bricks);
+				_world->setBlock(x, z, wallY+wallHeight-1, bricks);
 			}
 			for (int j = 0; j<wallHeight; j++) {
 				y = wallY + j;
-				std::shared_ptr<Object> wall_block1 = std::make_shared<Cube>(glm::vec3(wallX, z, y), textures_block2);
-				_scene3D->addEntity(wall_block1);
-				std::shared_ptr<Object> wall_block2 = std::make_shared<Cube>(glm::vec3(wallX+wallWidth-1, z, y), textures_block2);
-				_scene3D->addEntity(wall_block2);
+				_world->setBlock(wallX, z, y, bricks);
+				_world->setBlock(wallX+wallWidth-1, z, y, bricks);
 			}
 		}
 		for (int i = 1; i<wallWidth-1; i++) {
 			x = wallX + i;
 			for (int j = 0; j<wallHeight; j++) {
 				y = wallY + j;
-				std::shared_ptr<Object> floor_block = std::make_shared<Cube>(glm::vec3(x, wallZ, y), textures_block3);
-				_scene3D->addEntity(floor_block);
+				_world->setBlock(x, wallZ, y, wood);
 			}
 		}
+		_world->compact();
+		_scene3D->setWorld(_world);
+		LOG(Debug) << "World: " << _world->getChunkCount() << " chunks, " << _world->getMemoryUsage() << " bytes of block data";
+
+		// Blocs immobiles : matrices calculées une fois, ignorés par Scene3D::update
 		for (int i = 0; i<wallWidth; i++) {
 			x = wallX + i;
-			std::shared_ptr<Object> stair_block1 = std::make_shared<Stair>(glm::vec3(x, wallZ, wallY+wallHeight), textures_block3);
+			std::shared_ptr<Object> stair_block1 = makePooled<Stair>(glm::vec3(x, wallZ, wallY+wallHeight), textures_block3);
+			stair_block1->setStatic(true);
 			_scene3D->addEntity(stair_block1);
-			std::shared_ptr<Object> stair_block2 = std::make_shared<Stair>(glm::vec3(x, wallZ, wallY-1), textures_block3);
+			std::shared_ptr<Object> stair_block2 = makePooled<Stair>(glm::vec3(x, wallZ, wallY-1), textures_block3);
 			stair_block2->rotate(180.0f, AxisY); // rotation autour de l'axe y
+			stair_block2->setStatic(true);
 			_scene3D->addEntity(stair_block2);
 		}
 
 
-		std::shared_ptr<Object> inner_stair_block1 = std::make_shared<InnerStair>(glm::vec3(-18,1,-18), textures_block3);
+		std::shared_ptr<Object> inner_stair_block1 = makePooled<InnerStair>(glm::vec3(-18,1,-18), textures_block3);
 		inner_stair_block1->rotate(0.0f, AxisY); // rotation autour de l'axe y
+		inner_stair_block1->setStatic(true);
 		_scene3D->addEntity(inner_stair_block1);
-		std::shared_ptr<Object> inner_stair_block2 = std::make_shared<InnerStair>(glm::vec3(-18,1,-17), textures_block3);
+		std::shared_ptr<Object> inner_stair_block2 = makePooled<InnerStair>(glm::vec3(-18,1,-17), textures_block3);
 		inner_stair_block2->rotate(90.0f, AxisY); // rotation autour de l'axe y
+		inner_stair_block2->setStatic(true);
 		_scene3D->addEntity(inner_stair_block2);
-		std::shared_ptr<Object> inner_stair_block3 = std::make_shared<InnerStair>(glm::vec3(-17,1,-18), textures_block3);
+		std::shared_ptr<Object> inner_stair_block3 = makePooled<InnerStair>(glm::vec3(-17,1,-18), textures_block3);
 		inner_stair_block3->rotate(180.0f, AxisY); // rotation autour de l'axe y
+		inner_stair_block3->setStatic(true);
 		_scene3D->addEntity(inner_stair_block3);
-		std::shared_ptr<Object> inner_stair_block4 = std::make_shared<InnerStair>(glm::vec3(-17,1,-17), textures_block3);
+		std::shared_ptr<Object> inner_stair_block4 = makePooled<InnerStair>(glm::vec3(-17,1,-17), textures_block3);
 		inner_stair_block4->rotate(270.0f, AxisY); // rotation autour de l'axe y
+		inner_stair_block4->setStatic(true);
 		_scene3D->addEntity(inner_stair_block4);
 
 		if (!_scene3D->entitiesSetupSuccessfully()) {
@@ -329,6 +347,7 @@ bool Game::load() {
 
 		_camera->setPosition(glm::vec3(0.0f, 3.0f, 3.0f));
 
+		PoolAllocator::logAllStats();
 		LOG(Debug) << "Load scene success!";
 	} catch (const CustomException& e) {
 		e.generateLog();
@@ -346,6 +365,7 @@ void Game::unload() {
 	if (_isLoad) {
 		//_scene2D->reset();
 		_scene3D->reset();
+		_world.reset();
 		_isLoad = false;
 	}
 }
@@ -447,6 +467,33 @@ void Game::run(int argc, char *argv[]) {
 						break;
 					case SDLK_F2:
 					    _camera->setFreeMovement(!_camera->isFreeMovement());
+						break;
+					case SDLK_F3:
+						// Comparer le greedy meshing au meshing naïf (triangles et temps dans le log)
+						if (_world) {
+							bool greedy = _world->getMeshingMode() == Voxel::MeshingMode::Greedy;
+							_world->setMeshingMode(greedy ? Voxel::MeshingMode::Naive : Voxel::MeshingMode::Greedy);
+							LOG(Info) << "Meshing mode: " << (greedy ? "naive" : "greedy");
+						}
+						break;
+					case SDLK_F4: {
+						// Appels de dessin et changements d'état de la dernière image
+						const auto &stats = _scene3D->getRenderStats();
+						LOG(Info) << "Render: " << stats.visible << " visible, " << stats.culled << " culled, " << stats.occluded << " occluded, " << stats.unreachable << " unreachable, " << stats.drawCalls << " draw calls, " << stats.shaderBinds << " shader binds, "
+								  << stats.textureBinds << " texture binds, " << stats.vaoBinds << " VAO binds, "
+								  << stats.stateChangesAvoided << " state changes avoided, "
+								  << stats.uniformUploads << " uniform uploads (" << stats.uniformUploadsSkipped << " skipped)";
+						break;
+					}
+					case SDLK_F5:
+						// Comparer le rendu avec et sans le tampon d'occultation CPU (F4 pour les compteurs)
+						_scene3D->setOcclusionCulling(!_scene3D->isOcclusionCulling());
+						LOG(Info) << "Occlusion culling: " << (_scene3D->isOcclusionCulling() ? "on" : "off");
+						break;
+					case SDLK_F6:
+						_scene3D->setCaveCulling(!_scene3D->isCaveCulling());
+						LOG(Info) << "Cave culling: " << (_scene3D->isCaveCulling() ? "on" : "off");
+						break;
 					case SDLK_F9:
 						_scene2D->setEnable(!_scene2D->isEnable());
 						break;
@@ -494,6 +541,8 @@ void Game::run(int argc, char *argv[]) {
 		_camera->processKeyboard(deltaTime, cameraMovement);
 		// Mettre à jour la scène 3D
 		_scene3D->update(deltaTime);
+		// Envoyer au GPU une partie des meshes de chunks construits en arrière-plan
+		_scene3D->uploadChunkMeshes(CHUNK_UPLOAD_BUDGET);
 
 		// Effacer le tampon de couleur et le tampon de profondeur
 		glClearColor(Color::SKY_BLUE.r, Color::SKY_BLUE.g, Color::SKY_BLUE.b, Color::SKY_BLUE.a);
@@ -27,6 +27,7 @@
 #include "Core/Utils.hpp"
 #include "Render2D/Scene2D.hpp"
 #include "Render3D/Scene3D.hpp"
+#include "Voxel/World.hpp"
 
 #include <memory>
 #include <string>
@@ -34,6 +35,9 @@
 const std::string FONT_PATH  = "./resources/fonts/";
 const std::string IMAGE_PATH = "./resources/images/";
 
+// Temps maximal par frame pour envoyer au GPU les meshes de chunks (en millisecondes)
+const float CHUNK_UPLOAD_BUDGET = 2.0f;
+
 class Game {
 public:
 	Game();
@@ -74,6 +78,7 @@ private:
 
 	Render3D::CameraPtr  _camera;
 	Render3D::Scene3DPtr _scene3D;
+	Voxel::WorldPtr      _world;
 	Render2D::Scene2DPtr _scene2D;
 };
 
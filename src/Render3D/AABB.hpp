@@ -0,0 +1,84 @@
+#ifndef RENDER3D_AABB_HPP
+#define RENDER3D_AABB_HPP
+
+#include <glm/glm.hpp>
+#include <cmath>
+#include <algorithm>
+
+namespace Render3D {
+
+/// @brief Boîte englobante alignée sur les axes
+struct AABB {
+	glm::vec3 min = glm::vec3(0.0f);
+	glm::vec3 max = glm::vec3(0.0f);
+
+	glm::vec3 getCenter() const {
+		return (min + max) * 0.5f;
+	}
+
+	glm::vec3 getExtents() const {
+		return (max - min) * 0.5f;
+	}
+
+	bool contains(const glm::vec3 &point) const {
+		return point.x >= min.x && point.x <= max.x &&
+			   point.y >= min.y && point.y <= max.y &&
+			   point.z >= min.z && point.z <= max.z;
+	}
+
+	bool contains(const AABB &other) const {
+		return other.min.x >= min.x && other.max.x <= max.x &&
+			   other.min.y >= min.y && other.max.y <= max.y &&
+			   other.min.z >= min.z && other.max.z <= max.z;
+	}
+
+	bool overlaps(const AABB &other) const {
+		return min.x <= other.max.x && max.x >= other.min.x &&
+			   min.y <= other.max.y && max.y >= other.min.y &&
+			   min.z <= other.max.z && max.z >= other.min.z;
+	}
+
+	/// @brief Aire de la surface, coût d'un nœud pour l'heuristique SAH de AABBTree
+	float getSurfaceArea() const {
+		glm::vec3 size = max - min;
+		return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+	}
+
+	static AABB merge(const AABB &a, const AABB &b) {
+		return {glm::min(a.min, b.min), glm::max(a.max, b.max)};
+	}
+
+	/// @brief Test des dalles : intersection du rayon origin + t * direction avec la boîte, t dans [0, maxDistance]
+	/// @param inverseDirection 1 / direction (composantes infinies acceptées pour les axes nuls)
+	/// @param distance Distance d'entrée dans la boîte (0 si l'origine est dedans)
+	bool intersectsRay(const glm::vec3 &origin, const glm::vec3 &inverseDirection, float maxDistance, float &distance) const {
+		float tMin = 0.0f;
+		float tMax = maxDistance;
+		for (int axis = 0; axis < 3; ++axis) {
+			float t1 = (min[axis] - origin[axis]) * inverseDirection[axis];
+			float t2 = (max[axis] - origin[axis]) * inverseDirection[axis];
+			tMin = std::max(tMin, std::min(t1, t2));
+			tMax = std::min(tMax, std::max(t1, t2));
+		}
+		distance = tMin;
+		return tMin <= tMax;
+	}
+
+	/// @brief Boîte englobant cette boîte transformée, sans passer par ses 8 coins :
+	/// le centre est transformé, les demi-côtés sont projetés avec la valeur absolue de la matrice
+	AABB transformed(const glm::mat4 &matrix) const {
+		glm::vec3 center = glm::vec3(matrix * glm::vec4(getCenter(), 1.0f));
+		glm::vec3 extents = getExtents();
+		glm::vec3 newExtents(0.0f);
+		for (int row = 0; row < 3; ++row) {
+			for (int column = 0; column < 3; ++column) {
+				newExtents[row] += std::abs(matrix[column][row]) * extents[column];
+			}
+		}
+		return {center - newExtents, center + newExtents};
+	}
+};
+
+} // namespace Render3D
+
+#endif // RENDER3D_AABB_HPP
@@ -0,0 +1,340 @@
+#include "AABBTree.hpp"
+#include <algorithm>
+
+namespace Render3D {
+
+AABBTree::AABBTree(float margin)
+	: _root(NULL_NODE), _freeList(NULL_NODE), _leafCount(0), _margin(margin), _optimizeCursor(0) {}
+
+int AABBTree::allocateNode() {
+	if (_freeList == NULL_NODE) {
+		_nodes.emplace_back();
+		_nodes.back().height = 0;
+		return static_cast<int>(_nodes.size()) - 1;
+	}
+	int node = _freeList;
+	_freeList = _nodes[node].parent;
+	_nodes[node] = Node();
+	_nodes[node].height = 0;
+	return node;
+}
+
+void AABBTree::freeNode(int node) {
+	_nodes[node].parent = _freeList;
+	_nodes[node].height = -1;
+	_nodes[node].userData = nullptr;
+	_freeList = node;
+}
+
+int AABBTree::insert(const AABB &box, void *userData) {
+	int leaf = allocateNode();
+	_nodes[leaf].box = {box.min - glm::vec3(_margin), box.max + glm::vec3(_margin)};
+	_nodes[leaf].userData = userData;
+	insertLeaf(leaf);
+	_leafCount++;
+	return leaf;
+}
+
+void AABBTree::remove(int proxy) {
+	removeLeaf(proxy);
+	freeNode(proxy);
+	_leafCount--;
+}
+
+bool AABBTree::move(int proxy, const AABB &box) {
+	if (_nodes[proxy].box.contains(box)) {
+		return false;
+	}
+	removeLeaf(proxy);
+	_nodes[proxy].box = {box.min - glm::vec3(_margin), box.max + glm::vec3(_margin)};
+	insertLeaf(proxy);
+	return true;
+}
+
+void AABBTree::clear() {
+	_nodes.clear();
+	_root = NULL_NODE;
+	_freeList = NULL_NODE;
+	_leafCount = 0;
+	_optimizeCursor = 0;
+}
+
+void *AABBTree::getUserData(int proxy) const {
+	return _nodes[proxy].userData;
+}
+
+const AABB &AABBTree::getFatAABB(int proxy) const {
+	return _nodes[proxy].box;
+}
+
+std::size_t AABBTree::size() const {
+	return _leafCount;
+}
+
+int AABBTree::getHeight() const {
+	return _root == NULL_NODE ? -1 : _nodes[_root].height;
+}
+
+/* - - - - - - - - - - - - - - - - - - - - */
+
+void AABBTree::insertLeaf(int leaf) {
+	if (_root == NULL_NODE) {
+		_root = leaf;
+		_nodes[leaf].parent = NULL_NODE;
+		return;
+	}
+
+	/*
+		Descente : s'arrêter ici coûte la surface de la boîte fusionnée (nouveau parent),
+		descendre coûte l'agrandissement du fils plus l'agrandissement hérité par ce nœud
+	*/
+	const AABB leafBox = _nodes[leaf].box;
+	int index = _root;
+	while (!_nodes[index].isLeaf()) {
+		const Node &node = _nodes[index];
+		float area = node.box.getSurfaceArea();
+		float combinedArea = AABB::merge(node.box, leafBox).getSurfaceArea();
+		float cost = 2.0f * combinedArea;
+		float inheritance = 2.0f * (combinedArea - area);
+
+		float childCosts[2];
+		for (int i = 0; i < 2; ++i) {
+			const Node &child = _nodes[node.children[i]];
+			float mergedArea = AABB::merge(child.box, leafBox).getSurfaceArea();
+			childCosts[i] = (child.isLeaf() ? mergedArea : mergedArea - child.box.getSurfaceArea()) + inheritance;
+		}
+
+		if (cost < childCosts[0] && cost < childCosts[1]) {
+			break;
+		}
+		index = childCosts[0] < childCosts[1] ? node.children[0] : node.children[1];
+	}
+
+	// Nouveau parent commun à la feuille et au nœud trouvé
+	int sibling = index;
+	int oldParent = _nodes[sibling].parent;
+	int newParent = allocateNode();
+	_nodes[newParent].parent = oldParent;
+	_nodes[newParent].box = AABB::merge(leafBox, _nodes[sibling].box);
+	_nodes[newParent].height = _nodes[sibling].height + 1;
+	_nodes[newParent].children[0] = sibling;
+	_nodes[newParent].children[1] = leaf;
+	_nodes[sibling].parent = newParent;
+	_nodes[leaf].parent = newParent;
+
+	if (oldParent == NULL_NODE) {
+		_root = newParent;
+	} else {
+		int slot = _nodes[oldParent].children[0] == sibling ? 0 : 1;
+		_nodes[oldParent].children[slot] = newParent;
+	}
+
+	refitUpwards(_nodes[leaf].parent);
+}
+
+void AABBTree::removeLeaf(int leaf) {
+	if (leaf == _root) {
+		_root = NULL_NODE;
+		return;
+	}
+
+	int parent = _nodes[leaf].parent;
+	int grandParent = _nodes[parent].parent;
+	int sibling = _nodes[parent].children[0] == leaf ? _nodes[parent].children[1] : _nodes[parent].children[0];
+
+	if (grandParent == NULL_NODE) {
+		_root = sibling;
+		_nodes[sibling].parent = NULL_NODE;
+		freeNode(parent);
+		return;
+	}
+
+	// Le frère prend la place du parent
+	int slot = _nodes[grandParent].children[0] == parent ? 0 : 1;
+	_nodes[grandParent].children[slot] = sibling;
+	_nodes[sibling].parent = grandParent;
+	freeNode(parent);
+
+	refitUpwards(grandParent);
+}
+
+void AABBTree::refitUpwards(int node) {
+	while (node != NULL_NODE) {
+		node = balance(node);
+
+		Node &current = _nodes[node];
+		const Node &left = _nodes[current.children[0]];
+		const Node &right = _nodes[current.children[1]];
+		current.height = 1 + std::max(left.height, right.height);
+		current.box = AABB::merge(left.box, right.box);
+
+		node = current.parent;
+	}
+}
+
+int AABBTree::balance(int iA) {
+	Node &A = _nodes[iA];
+	if (A.isLeaf() || A.height < 2) {
+		return iA;
+	}
+
+	int iB = A.children[0];
+	int iC = A.children[1];
+	Node &B = _nodes[iB];
+	Node &C = _nodes[iC];
+	int difference = C.height - B.height;
+
+	// Fait monter le fils trop haut (up) à la place de A ; son petit-fils le plus haut reste sous lui,
+	// l'autre descend sous A à la place de up
+	auto rotate = [&](int iUp, int slotOfUp, int iOther) {
+		Node &up = _nodes[iUp];
+		int iF = up.children[0];
+		int iG = up.children[1];
+
+		up.children[0] = iA;
+		up.parent = A.parent;
+		A.parent = iUp;
+		if (up.parent == NULL_NODE) {
+			_root = iUp;
+		} else if (_nodes[up.parent].children[0] == iA) {
+			_nodes[up.parent].children[0] = iUp;
+		} else {
+			_nodes[up.parent].children[1] = iUp;
+		}
+
+		int iKeep = _nodes[iF].height > _nodes[iG].height ? iF : iG;
+		int iMove = iKeep == iF ? iG : iF;
+		up.children[1] = iKeep;
+		A.children[slotOfUp] = iMove;
+		_nodes[iMove].parent = iA;
+
+		const Node &other = _nodes[iOther];
+		A.box = AABB::merge(other.box, _nodes[iMove].box);
+		A.height = 1 + std::max(other.height, _nodes[iMove].height);
+		up.box = AABB::merge(A.box, _nodes[iKeep].box);
+		up.height = 1 + std::max(A.height, _nodes[iKeep].height);
+		return iUp;
+	};
+
+	if (difference > 1) {
+		return rotate(iC, 1, iB);
+	}
+	if (difference < -1) {
+		return rotate(iB, 0, iC);
+	}
+	return iA;
+}
+
+/* - - - - - - - - - - - - - - - - - - - - */
+
+void AABBTree::rebuild() {
+	std::vector<int> leaves;
+	leaves.reserve(_leafCount);
+	for (std::size_t i = 0; i < _nodes.size(); ++i) {
+		if (_nodes[i].height < 0) {
+			continue;
+		}
+		if (_nodes[i].isLeaf()) {
+			leaves.push_back(static_cast<int>(i));
+		} else {
+			freeNode(static_cast<int>(i));
+		}
+	}
+
+	_root = leaves.empty() ? NULL_NODE : buildTopDown(leaves, 0, leaves.size());
+	if (_root != NULL_NODE) {
+		_nodes[_root].parent = NULL_NODE;
+	}
+}
+
+int AABBTree::buildTopDown(std::vector<int> &leaves, std::size_t begin, std::size_t end) {
+	if (end - begin == 1) {
+		return leaves[begin];
+	}
+
+	// Découpe à la médiane des centres sur l'axe où ils sont le plus étalés
+	glm::vec3 centerMin(_nodes[leaves[begin]].box.getCenter());
+	glm::vec3 centerMax(centerMin);
+	for (std::size_t i = begin + 1; i < end; ++i) {
+		glm::vec3 center = _nodes[leaves[i]].box.getCenter();
+		centerMin = glm::min(centerMin, center);
+		centerMax = glm::max(centerMax, center);
+	}
+	glm::vec3 spread = centerMax - centerMin;
+	int axis = spread.x > spread.y ? (spread.x > spread.z ? 0 : 2) : (spread.y > spread.z ? 1 : 2);
+
+	std::size_t middle = begin + (end - begin) / 2;
+	std::nth_element(leaves.begin() + begin, leaves.begin() + middle, leaves.begin() + end, [&](int a, int b) {
+		return _nodes[a].box.getCenter()[axis] < _nodes[b].box.getCenter()[axis];
+	});
+
+	int left = buildTopDown(leaves, begin, middle);
+	int right = buildTopDown(leaves, middle, end);
+
+	int node = allocateNode();
+	_nodes[node].children[0] = left;
+	_nodes[node].children[1] = right;
+	_nodes[node].box = AABB::merge(_nodes[left].box, _nodes[right].box);
+	_nodes[node].height = 1 + std::max(_nodes[left].height, _nodes[right].height);
+	_nodes[left].parent = node;
+	_nodes[right].parent = node;
+	return node;
+}
+
+void AABBTree::optimize(int count) {
+	if (_leafCount < 2) {
+		return;
+	}
+	while (count > 0) {
+		_optimizeCursor = (_optimizeCursor + 1) % _nodes.size();
+		if (_nodes[_optimizeCursor].height != 0) {
+			continue;
+		}
+		int leaf = static_cast<int>(_optimizeCursor);
+		removeLeaf(leaf);
+		insertLeaf(leaf);
+		count--;
+	}
+}
+
+/* - - - - - - - - - - - - - - - - - - - - */
+
+float AABBTree::getAreaRatio() const {
+	if (_root == NULL_NODE) {
+		return 0.0f;
+	}
+	float total = 0.0f;
+	for (const auto &node : _nodes) {
+		if (node.height > 0) {
+			total += node.box.getSurfaceArea();
+		}
+	}
+	return total / _nodes[_root].box.getSurfaceArea();
+}
+
+bool AABBTree::validate() const {
+	std::size_t leaves = 0;
+	for (std::size_t i = 0; i < _nodes.size(); ++i) {
+		const Node &node = _nodes[i];
+		if (node.height < 0) {
+			continue;
+		}
+		if ((node.parent == NULL_NODE) != (static_cast<int>(i) == _root)) {
+			return false;
+		}
+		if (node.isLeaf()) {
+			leaves++;
+			continue;
+		}
+		const Node &left = _nodes[node.children[0]];
+		const Node &right = _nodes[node.children[1]];
+		if (left.parent != static_cast<int>(i) || right.parent != static_cast<int>(i) ||
+			node.height != 1 + std::max(left.height, right.height) ||
+			!node.box.contains(left.box) || !node.box.contains(right.box)) {
+			return false;
+		}
+	}
+	return leaves == _leafCount;
+}
+
+} // namespace Render3D
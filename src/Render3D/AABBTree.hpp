@@ -0,0 +1,214 @@
+#ifndef RENDER3D_AABB_TREE_HPP
+#define RENDER3D_AABB_TREE_HPP
+
+#include <vector>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include "AABB.hpp"
+#include "Frustum.hpp"
+
+namespace Render3D {
+
+/*
+	Arbre dynamique de boîtes englobantes (BVH) pour les entités de la scène.
+
+	- Chaque feuille porte une boîte « grasse » (boîte de l'objet + marge) : un objet qui
+	  bouge un peu reste dans sa boîte et l'arbre n'est pas modifié.
+	- Insertion : on descend vers le fils dont l'agrandissement coûte le moins en surface (SAH),
+	  puis on remonte en recalculant les boîtes et en équilibrant par rotations (comme un AVL).
+	- Les requêtes (frustum, boîte, rayon) ne visitent que les branches qui peuvent répondre : O(log n).
+
+	Les identifiants retournés par insert() restent valables jusqu'à remove(), même après rebuild().
+*/
+class AABBTree {
+public:
+	static constexpr int NULL_NODE = -1;
+
+	/// @param margin Marge ajoutée autour des boîtes des feuilles
+	AABBTree(float margin = 0.1f);
+
+	/// @brief Ajouter une boîte
+	/// @return Identifiant de la feuille (proxy)
+	int insert(const AABB &box, void *userData);
+	void remove(int proxy);
+	/// @brief Mettre à jour la boîte d'une feuille après un déplacement
+	/// @return true si la feuille a dû être réinsérée (la boîte est sortie de sa boîte grasse)
+	bool move(int proxy, const AABB &box);
+	void clear();
+
+	/// @brief Reconstruction complète de haut en bas (découpe à la médiane sur le plus grand axe)
+	void rebuild();
+	/// @brief Reconstruction incrémentale : réinsérer count feuilles à chaque appel, à tour de rôle
+	void optimize(int count);
+
+	void *getUserData(int proxy) const;
+	const AABB &getFatAABB(int proxy) const;
+	std::size_t size() const;
+	/// @brief Hauteur de l'arbre (0 pour une seule feuille, -1 si vide)
+	int getHeight() const;
+	/// @brief Somme des surfaces des nœuds internes / surface de la racine (qualité de l'arbre, plus petit = mieux)
+	float getAreaRatio() const;
+	/// @brief Vérifier parents, hauteurs et boîtes de tous les nœuds (débogage)
+	bool validate() const;
+
+	/// @brief Appeler callback(userData) pour chaque feuille dont la boîte grasse chevauche box
+	template <typename Callback>
+	void query(const AABB &box, Callback &&callback) const;
+
+	/// @brief Appeler callback(userData) pour chaque feuille dans le frustum
+	/// Une branche entièrement dans le frustum est parcourue sans plus aucun test
+	template <typename Callback>
+	void query(const Frustum &frustum, Callback &&callback) const;
+
+	/// @brief Lancer un rayon : callback(userData, distance) est appelé pour chaque feuille touchée
+	/// à moins de maxDistance et retourne la nouvelle distance maximale (sa distance pour ne garder que plus proche)
+	template <typename Callback>
+	void raycast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, Callback &&callback) const;
+
+private:
+	struct Node {
+		AABB box;
+		void *userData = nullptr;
+		int parent = NULL_NODE;		// suivant dans la liste libre pour un nœud libre
+		int children[2] = {NULL_NODE, NULL_NODE};
+		int height = -1;			// 0 pour une feuille, -1 pour un nœud libre
+
+		bool isLeaf() const {
+			return children[0] == NULL_NODE;
+		}
+	};
+
+	/// @brief Pile de parcours des requêtes : un tableau local suffit pour un arbre équilibré
+	/// (hauteur ~1.44 log2 n), les nœuds au-delà passent dans un vector si l'arbre est dégénéré
+	class TraversalStack {
+	public:
+		void push(int node) {
+			if (_count < INLINE_SIZE) {
+				_inline[_count] = node;
+			} else {
+				_overflow.push_back(node);
+			}
+			_count++;
+		}
+
+		int pop() {
+			_count--;
+			if (_count < INLINE_SIZE) {
+				return _inline[_count];
+			}
+			int node = _overflow.back();
+			_overflow.pop_back();
+			return node;
+		}
+
+		bool empty() const {
+			return _count == 0;
+		}
+
+	private:
+		static constexpr std::size_t INLINE_SIZE = 64;
+
+		int _inline[INLINE_SIZE];
+		std::size_t _count = 0;
+		std::vector<int> _overflow;
+	};
+
+	int allocateNode();
+	void freeNode(int node);
+	void insertLeaf(int leaf);
+	void removeLeaf(int leaf);
+	/// @brief Rotation simple si les hauteurs des deux fils diffèrent de plus de 1
+	/// (garde l'arbre équilibré en pratique, sans garantie stricte d'AVL)
+	/// @return Nœud qui a pris la place de node
+	int balance(int node);
+	/// @brief Recalculer boîte et hauteur en remontant jusqu'à la racine
+	void refitUpwards(int node);
+	int buildTopDown(std::vector<int> &leaves, std::size_t begin, std::size_t end);
+
+	std::vector<Node> _nodes;
+	int _root;
+	int _freeList;
+	std::size_t _leafCount;
+	float _margin;
+	std::size_t _optimizeCursor;
+};
+
+/* - - - - - - - - - - - - - - - - - - - - */
+
+template <typename Callback>
+void AABBTree::query(const AABB &box, Callback &&callback) const {
+	if (_root == NULL_NODE) {
+		return;
+	}
+	TraversalStack stack;
+	stack.push(_root);
+	while (!stack.empty()) {
+		const Node &node = _nodes[stack.pop()];
+		if (!node.box.overlaps(box)) {
+			continue;
+		}
+		if (node.isLeaf()) {
+			callback(node.userData);
+		} else {
+			stack.push(node.children[0]);
+			stack.push(node.children[1]);
+		}
+	}
+}
+
+template <typename Callback>
+void AABBTree::query(const Frustum &frustum, Callback &&callback) const {
+	if (_root == NULL_NODE) {
+		return;
+	}
+	// Le bit de poids faible indique une branche déjà entièrement dans le frustum
+	TraversalStack stack;
+	stack.push(_root << 1);
+	while (!stack.empty()) {
+		int entry = stack.pop();
+		const Node &node = _nodes[entry >> 1];
+		bool inside = entry & 1;
+		if (!inside) {
+			if (!frustum.AABBIsInside(node.box)) {
+				continue;
+			}
+			inside = !node.isLeaf() && frustum.AABBIsFullyInside(node.box);
+		}
+		if (node.isLeaf()) {
+			callback(node.userData);
+		} else {
+			stack.push((node.children[0] << 1) | inside);
+			stack.push((node.children[1] << 1) | inside);
+		}
+	}
+}
+
+template <typename Callback>
+void AABBTree::raycast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, Callback &&callback) const {
+	if (_root == NULL_NODE) {
+		return;
+	}
+	const glm::vec3 inverseDirection = 1.0f / direction;
+	TraversalStack stack;
+	stack.push(_root);
+	while (!stack.empty()) {
+		const Node &node = _nodes[stack.pop()];
+		float distance;
+		if (!node.box.intersectsRay(origin, inverseDirection, maxDistance, distance)) {
+			continue;
+		}
+		if (node.isLeaf()) {
+			maxDistance = callback(node.userData, distance);
+			if (maxDistance <= 0.0f) {
+				return;
+			}
+		} else {
+			stack.push(node.children[0]);
+			stack.push(node.children[1]);
+		}
+	}
+}
+
+} // namespace Render3D
+
+#endif // RENDER3D_AABB_TREE_HPP
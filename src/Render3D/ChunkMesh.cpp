@@ -0,0 +1,125 @@
+#include "ChunkMesh.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace Render3D {
+
+ChunkMesh::ChunkMesh(const Voxel::ChunkPos &position)
+	: _position(position), _faceConnections(Voxel::FaceConnections::all()), _vao(0), _vbo(0), _ebo(0), _indexCount(0), _transparentOffset(0), _pendingJob(0), _isMeshSetup(false) {
+	glm::vec3 origin = glm::vec3(position.x, position.y, position.z) * static_cast<float>(Voxel::CHUNK_SIZE);
+	_modelMatrix = glm::translate(glm::mat4(1.0f), origin);
+	_center = origin + glm::vec3(Voxel::CHUNK_SIZE / 2.0f - 0.5f);
+	// Les blocs sont centrés sur leurs coordonnées entières
+	_worldAABB = {origin - glm::vec3(0.5f), origin + glm::vec3(Voxel::CHUNK_SIZE - 0.5f)};
+}
+
+ChunkMesh::~ChunkMesh() {
+	free();
+}
+
+void ChunkMesh::upload(const Voxel::ChunkMeshData &data) {
+	_stats = data.stats;
+	_indexCount = data.indices.size();
+	_transparentOffset = data.transparentOffset;
+	_faceConnections = data.faceConnections;
+
+	// Coins entiers des blocs -> monde, comme dans shader_3d_chunk.vert
+	glm::vec3 origin = _worldAABB.min;
+	_occluders.clear();
+	_occluders.reserve(data.occluders.size());
+	for (const auto &quad : data.occluders) {
+		_occluders.push_back({origin + glm::vec3(quad.min[0], quad.min[1], quad.min[2]),
+							  origin + glm::vec3(quad.max[0], quad.max[1], quad.max[2])});
+	}
+
+	if (!_isMeshSetup) {
+		glGenVertexArrays(1, &_vao);
+		glGenBuffers(1, &_vbo);
+		glGenBuffers(1, &_ebo);
+	}
+
+	glBindVertexArray(_vao);
+
+	glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+	glBufferData(GL_ARRAY_BUFFER, data.vertices.size() * sizeof(Voxel::ChunkVertex), data.vertices.data(), GL_STATIC_DRAW);
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, data.indices.size() * sizeof(unsigned int), data.indices.data(), GL_STATIC_DRAW);
+
+	// Sommets compacts de 8 octets (voir Voxel::ChunkVertex), décodés dans shader_3d_chunk.vert
+	glVertexAttribIPointer(0, 2, GL_UNSIGNED_INT, sizeof(Voxel::ChunkVertex), (void*)(0));
+	glEnableVertexAttribArray(0);
+
+	glBindVertexArray(0);
+
+	_isMeshSetup = true;
+}
+
+bool ChunkMesh::isEmpty() const {
+	return _stats.emittedFaces == 0;
+}
+
+const Voxel::MeshStats &ChunkMesh::getStats() const {
+	return _stats;
+}
+
+const AABB &ChunkMesh::getWorldAABB() const {
+	return _worldAABB;
+}
+
+const std::vector<AABB> &ChunkMesh::getOccluders() const {
+	return _occluders;
+}
+
+const Voxel::FaceConnections &ChunkMesh::getFaceConnections() const {
+	return _faceConnections;
+}
+
+const Voxel::ChunkPos &ChunkMesh::getPosition() const {
+	return _position;
+}
+
+uint64_t ChunkMesh::getPendingJob() const {
+	return _pendingJob;
+}
+
+void ChunkMesh::setPendingJob(uint64_t jobID) {
+	_pendingJob = jobID;
+}
+
+const glm::mat4 &ChunkMesh::modelMatrix() const {
+	return _modelMatrix;
+}
+
+void ChunkMesh::enqueue(RenderQueue &queue, const Shader &shader, const TextureArray &blockTextures) const {
+	if (!_isMeshSetup || _indexCount == 0) {
+		return;
+	}
+
+	DrawCommand command;
+	command.shader = &shader;
+	command.textureTarget = GL_TEXTURE_2D_ARRAY;
+	command.texture = blockTextures.getID();
+	command.vao = _vao;
+	command.model = &_modelMatrix;
+	if (_transparentOffset > 0) {
+		command.count = _transparentOffset;
+		queue.push(command, _center);
+	}
+	if (_transparentOffset < _indexCount) {
+		command.offset = _transparentOffset;
+		command.count = _indexCount - _transparentOffset;
+		command.transparent = true;
+		queue.push(command, _center);
+	}
+}
+
+void ChunkMesh::free() {
+	if (_isMeshSetup) {
+		glDeleteVertexArrays(1, &_vao);
+		glDeleteBuffers(1, &_vbo);
+		glDeleteBuffers(1, &_ebo);
+		_isMeshSetup = false;
+	}
+}
+
+} // namespace Render3D
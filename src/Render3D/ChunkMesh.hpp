@@ -0,0 +1,68 @@
+#ifndef RENDER3D_CHUNK_MESH_HPP
+#define RENDER3D_CHUNK_MESH_HPP
+
+#include <vector>
+#include <memory>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include "../Core/Shader.hpp"
+#include "../Core/TextureArray.hpp"
+#include "RenderQueue.hpp"
+#include "AABB.hpp"
+#include "../Voxel/ChunkMesher.hpp"
+
+namespace Render3D {
+
+/// @brief Mesh GPU d'un chunk : un seul VAO/VBO/EBO pour tous ses blocs
+class ChunkMesh {
+public:
+	ChunkMesh(const Voxel::ChunkPos &position);
+	~ChunkMesh();
+
+	ChunkMesh(const ChunkMesh &) = delete;
+	ChunkMesh &operator=(const ChunkMesh &) = delete;
+
+	/// @brief Envoyer au GPU la géométrie générée par Voxel::ChunkMesher
+	void upload(const Voxel::ChunkMeshData &data);
+
+	bool isEmpty() const;
+	const Voxel::MeshStats &getStats() const;
+
+	/// @brief Dernier travail de construction soumis pour ce chunk (les résultats plus anciens sont ignorés)
+	uint64_t getPendingJob() const;
+	void setPendingJob(uint64_t jobID);
+	const glm::mat4 &modelMatrix() const;
+	/// @brief Boîte du chunk entier dans le monde (fixe, calculée à la construction)
+	const AABB &getWorldAABB() const;
+	/// @brief Grandes faces opaques dans le monde (rectangles plats), pour OcclusionBuffer
+	const std::vector<AABB> &getOccluders() const;
+	/// @brief Faces du chunk reliées par l'air (toutes tant que le mesh n'est pas construit)
+	const Voxel::FaceConnections &getFaceConnections() const;
+	const Voxel::ChunkPos &getPosition() const;
+
+	/// @brief Ajouter le chunk à la file de rendu (textures des blocs en tableau) : un appel pour
+	/// les faces opaques, un second marqué transparent pour celles des blocs transparents
+	void enqueue(RenderQueue &queue, const Shader &shader, const TextureArray &blockTextures) const;
+
+private:
+	void free();
+
+	Voxel::ChunkPos _position;
+	glm::mat4 _modelMatrix;
+	glm::vec3 _center;
+	AABB _worldAABB;
+	std::vector<AABB> _occluders;
+	Voxel::FaceConnections _faceConnections;
+	GLuint _vao, _vbo, _ebo;
+	unsigned int _indexCount;
+	unsigned int _transparentOffset;	// premier indice des faces transparentes
+	Voxel::MeshStats _stats;
+	uint64_t _pendingJob;
+	bool _isMeshSetup;
+};
+
+using ChunkMeshPtr = std::unique_ptr<ChunkMesh>;
+
+} // namespace Render3D
+
+#endif // RENDER3D_CHUNK_MESH_HPP
@@ -6,7 +6,12 @@ Cube::Cube(const glm::vec3 &position, const std::vector<glm::vec4> facesColors)
     : Object("Object:Cube", position, facesColors, colorFaces(CUBE_VERTICES, facesColors), CUBE_INDICES, CUBE_NUMBER_OF_INDICES_PER_FACE) {}
 
 Cube::Cube(const glm::vec3 &position, const std::array<std::shared_ptr<Texture>, 6> textures)
-    : Object("Object:Cube", position, textures, CUBE_VERTICES, CUBE_INDICES, CUBE_NUMBER_OF_INDICES_PER_FACE) {}
+    : Object("Object:Cube", position, textures, geometry()) {}
+
+ObjectGeometryPtr Cube::geometry() {
+    static const ObjectGeometryPtr geometry = std::make_shared<ObjectGeometry>(ObjectGeometry{CUBE_VERTICES, CUBE_INDICES, CUBE_NUMBER_OF_INDICES_PER_FACE});
+    return geometry;
+}
 
 std::vector<float> Cube::colorFaces(const std::vector<float> &vertices, const std::vector<glm::vec4> &facesColors) {
     // Copiez le vecteur d'entrée pour modification
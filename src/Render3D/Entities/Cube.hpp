@@ -81,6 +81,9 @@ public:
 	Cube(const glm::vec3 &position, const std::vector<glm::vec4> facesColors);
 	Cube(const glm::vec3 &position, const std::array<std::shared_ptr<Texture>, 6> textures);
 
+	/// @brief Géométrie commune à tous les objets Cube texturés
+	static ObjectGeometryPtr geometry();
+
 private:
 	std::vector<float> colorFaces(const std::vector<float> &vertices, const std::vector<glm::vec4> &facesColors);
 };
@@ -16,15 +16,18 @@
 #define ENTITY_HPP
 
 #include <array>
+#include <cstdint>
 #include <glm/glm.hpp>
 #include "../../Core/Shader.hpp"
+#include "../RenderQueue.hpp"
+#include "../AABB.hpp"
 #include <vector>
 
 namespace Render3D {
 
 class Entity {
 public:
-	Entity(const std::string &typeName) : _typeName(typeName) {}
+	Entity(const std::string &typeName) : _typeName(typeName), _static(false) {}
 
 	virtual ~Entity() = default;
 
@@ -32,6 +35,15 @@ public:
 
 	bool virtual setupSuccessfully() const { return true; }
 
+	/// @brief Entité dessinée par InstancedRenderer plutôt que par render()
+	virtual bool isInstanced() const { return false; }
+
+	/// @brief Entité immobile : la scène ne l'appelle plus à chaque image et garde sa matrice en cache
+	/// Une entité statique déplacée doit être signalée à la scène (Scene3D::refreshEntity)
+	/// À choisir avant l'ajout à la scène
+	void setStatic(bool isStatic) { _static = isStatic; }
+	bool isStatic() const { return _static; }
+
 	virtual glm::vec3 &position() = 0;
 	virtual const glm::vec3 &position() const = 0;
 	virtual void position(const glm::vec3 &point) = 0;
@@ -53,8 +65,13 @@ public:
 	virtual void rotateAxis(const glm::vec3 &axis) = 0;
 
 	virtual const glm::mat4 &modelMatrix() const = 0;
+	/// @brief Change à chaque recalcul de la matrice du modèle (déplacement de l'entité ou d'un parent)
+	virtual uint32_t getTransformVersion() const = 0;
 
 	virtual std::vector<glm::vec3> getBoundingBoxCorners() const = 0;
+
+	/// @brief Boîte englobante dans l'espace du monde, recalculée seulement quand la transformation change
+	virtual const AABB &getWorldAABB() const = 0;
 	bool contains(const glm::vec3 &point) const;
 
 	bool overlaps(const Entity &other) const;
@@ -68,11 +85,13 @@ public:
 	bool isBehindOf(const Entity &other) const;
 
 	virtual void update(float dt) = 0;
-	virtual void render(const Shader &shader) const = 0;
+	/// @brief Ajouter les appels de dessin de l'entité à la file de rendu
+	virtual void enqueue(RenderQueue &queue, const Shader &shader) const = 0;
 
 protected:
 
 	std::string _typeName;
+	bool _static;
 };
 
 }
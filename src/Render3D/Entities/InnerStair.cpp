@@ -6,7 +6,12 @@ InnerStair::InnerStair(const glm::vec3 &position, const std::vector<glm::vec4> f
     : Object("object:InnerStair", position, facesColors, colorFaces(INNER_STAIR_VERTICES, facesColors), INNER_STAIR_INDICES, INNER_STAIR_NUMBER_OF_INDICES_PER_FACE) {}
 
 InnerStair::InnerStair(const glm::vec3 &position, const std::array<std::shared_ptr<Texture>, 6> faceTexture)
-    : Object("object:InnerStair", position, faceTexture, INNER_STAIR_VERTICES, INNER_STAIR_INDICES, INNER_STAIR_NUMBER_OF_INDICES_PER_FACE) {}
+    : Object("object:InnerStair", position, faceTexture, geometry()) {}
+
+ObjectGeometryPtr InnerStair::geometry() {
+    static const ObjectGeometryPtr geometry = std::make_shared<ObjectGeometry>(ObjectGeometry{INNER_STAIR_VERTICES, INNER_STAIR_INDICES, INNER_STAIR_NUMBER_OF_INDICES_PER_FACE});
+    return geometry;
+}
 
 std::vector<float> InnerStair::colorFaces(const std::vector<float> &vertices, const std::vector<glm::vec4> &facesColors) {
     // Copiez le vecteur d'entrée pour modification
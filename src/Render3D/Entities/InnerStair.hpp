@@ -206,6 +206,9 @@ public:
 	InnerStair(const glm::vec3 &position, const std::vector<glm::vec4> facesColors);
 	InnerStair(const glm::vec3 &position, const std::array<std::shared_ptr<Texture>, 6> faceTexture);
 
+	/// @brief Géométrie commune à tous les objets InnerStair texturés
+	static ObjectGeometryPtr geometry();
+
 private:
 	std::vector<float> colorFaces(const std::vector<float> &vertices, const std::vector<glm::vec4> &facesColors);
 };
@@ -6,26 +6,29 @@
 namespace Render3D {
 
 Object::Object(const std::string &typeName, const glm::vec3 &position, const std::vector<glm::vec4> &facesColors, const std::vector<float> &vertices, const std::vector<unsigned int> &indices, const std::vector<unsigned int> &numberOfIndicesPerFace) 
-	: Entity(typeName), _drawType(DrawType::Colored), _position(position), _angle(0.0f), _rotateAxis(glm::vec3(0.0f, 1.0f, 0.0f)), _facesColor(facesColors) {
+	: Entity(typeName), _drawType(DrawType::Colored), _transform(position), _angle(0.0f), _rotateAxis(glm::vec3(0.0f, 1.0f, 0.0f)), _rotationDirty(false), _worldAABBVersion(0), _facesColor(facesColors) {
 	setupMesh(vertices, indices, numberOfIndicesPerFace);
-	updateModelMatrix();
 }
 
 Object::Object(const std::string &typeName, const glm::vec3 &position, const std::array<std::shared_ptr<Texture>, 6> &facesTextures, const std::vector<float> &vertices, const std::vector<unsigned int> &indices, const std::vector<unsigned int> &numberOfIndicesPerFace) 
-	: Entity(typeName), _drawType(DrawType::Textured), _position(position), _angle(0.0f), _rotateAxis(glm::vec3(0.0f, 1.0f, 0.0f)), _facesTextures(facesTextures) {
+	: Entity(typeName), _drawType(DrawType::Textured), _transform(position), _angle(0.0f), _rotateAxis(glm::vec3(0.0f, 1.0f, 0.0f)), _rotationDirty(false), _worldAABBVersion(0), _facesTextures(facesTextures) {
 	setupMesh(vertices, indices, numberOfIndicesPerFace);
-	updateModelMatrix();
 }
 
 Object::Object(const std::string &typeName, const glm::vec3 &position, const std::array<std::shared_ptr<Texture>, 6> &facesTextures, const std::string &filename, FormatFile format)
-	: Entity(typeName), _drawType(DrawType::Textured), _position(position), _angle(0.0f), _rotateAxis(glm::vec3(0.0f, 1.0f, 0.0f)), _facesTextures(facesTextures) {
+	: Entity(typeName), _drawType(DrawType::Textured), _transform(position), _angle(0.0f), _rotateAxis(glm::vec3(0.0f, 1.0f, 0.0f)), _rotationDirty(false), _worldAABBVersion(0), _facesTextures(facesTextures) {
 	
 	if (!loadMeshFromFile(filename, format)) {
 		LOG(Error) << "Mesh could not be loaded from file: " << filename;
 		_typeName = "Object:Error";
 		_drawType = DrawType::Colored;
 	}
-	updateModelMatrix();
+}
+
+Object::Object(const std::string &typeName, const glm::vec3 &position, const std::array<std::shared_ptr<Texture>, 6> &facesTextures, ObjectGeometryPtr geometry)
+	: Entity(typeName), _drawType(DrawType::Textured), _transform(position), _angle(0.0f), _rotateAxis(glm::vec3(0.0f, 1.0f, 0.0f)), _rotationDirty(false), _worldAABBVersion(0), _facesTextures(facesTextures),
+	  _geometry(geometry), _vao(0), _vbo(0), _ebo(0), _numberOfIndicesPerFace(geometry->numberOfIndicesPerFace), _isMeshSetup(false) {
+	_localAABB = computeLocalAABB(geometry->vertices);
 }
 
 Object::~Object() {
@@ -53,6 +56,8 @@ void Object::setupMesh(std::vector<float> vertices, std::vector<unsigned int> in
 
 	// Stocker le nombre d'indices par face
 	_numberOfIndicesPerFace = numberOfIndicesPerFace;
+	_localAABB = computeLocalAABB(vertices);
+	_worldAABBVersion = 0;	// versions de transformation >= 1 : la boîte sera recalculée
 
 	// Générer les buffers et l'array object
 	glGenVertexArrays(1, &_vao);
@@ -95,7 +100,7 @@ bool Object::loadMeshFromFile(const std::string &meshFile, FormatFile format) {
 }
 
 bool Object::setupSuccessfully() const {
-    return _isMeshSetup;
+    return _isMeshSetup || _geometry;
 }
 
 void Object::free() {
@@ -110,6 +115,10 @@ void Object::free() {
 void Object::setFacesColors(const std::vector<glm::vec4> &facesColors) {
 	_facesColor = facesColors;
 	_drawType = DrawType::Colored;
+	// Un objet instancié coloré n'est plus dessiné par InstancedRenderer : il lui faut ses propres buffers
+	if (_geometry && !_isMeshSetup) {
+		setupMesh(_geometry->vertices, _geometry->indices, _geometry->numberOfIndicesPerFace);
+	}
 }
 
 void Object::setFacesTextures(const std::array<std::shared_ptr<Texture>, 6> &facesTextures) {
@@ -117,26 +126,42 @@ void Object::setFacesTextures(const std::array<std::shared_ptr<Texture>, 6> &fac
 	_drawType = DrawType::Textured;
 }
 
+const std::array<std::shared_ptr<Texture>, 6> &Object::getFacesTextures() const {
+	return _facesTextures;
+}
+
+bool Object::isTextured() const {
+	return _drawType == DrawType::Textured;
+}
+
+ObjectGeometryPtr Object::getGeometry() const {
+	return _geometry;
+}
+
+bool Object::isInstanced() const {
+	return _geometry != nullptr;
+}
+
 glm::vec3 &Object::position() {
-	return _position;
+	return _transform.getPosRef();
 }
 
 const glm::vec3 &Object::position() const {
-	return _position;
+	return _transform.getPos();
 }
 
 void Object::position(const glm::vec3 &point) {
-	_position = point;
-	updateModelMatrix();
+	_transform.setPos(point);
 }
 
 void Object::rotate(float angle, const glm::vec3 &axis) {
 	_angle = angle;
 	_rotateAxis = axis;
-	updateModelMatrix();
+	_rotationDirty = true;
 }
 
 float &Object::angle() {
+	_rotationDirty = true;
 	return _angle;
 }
 
@@ -146,10 +171,11 @@ const float &Object::angle() const {
 
 void Object::angle(float angle) {
 	_angle = angle;
-	updateModelMatrix();
+	_rotationDirty = true;
 }
 
 glm::vec3 &Object::rotateAxis() {
+	_rotationDirty = true;
 	return _rotateAxis;
 }
 
@@ -159,23 +185,49 @@ const glm::vec3 &Object::rotateAxis() const {
 
 void Object::rotateAxis(const glm::vec3 &axis) {
 	_rotateAxis = axis;
-	updateModelMatrix();
+	_rotationDirty = true;
+}
+
+void Object::updateRotation() const {
+	if (_rotationDirty) {
+		// Même rotation que glm::rotate(angle, axe) : l'axe n'a pas besoin d'être normalisé
+		_transform.setRot(glm::angleAxis(glm::radians(_angle), glm::normalize(_rotateAxis)));
+		_rotationDirty = false;
+	}
 }
 
 const glm::mat4 &Object::modelMatrix() const {
-	return _modelMatrix;
+	updateRotation();
+	return _transform.getWorldMatrix();
+}
+
+uint32_t Object::getTransformVersion() const {
+	updateRotation();
+	return _transform.getVersion();
+}
+
+void Object::setParent(const Object *parent) {
+	_transform.setParent(parent ? &parent->_transform : nullptr);
 }
 
-void Object::updateModelMatrix() {
-	_modelMatrix = glm::mat4(1.0f);
-	_modelMatrix = glm::translate(_modelMatrix, _position);
-	_modelMatrix = glm::rotate(_modelMatrix, glm::radians(_angle), _rotateAxis);
+AABB Object::computeLocalAABB(const std::vector<float> &vertices) {
+	if (vertices.size() < 3) {
+		return {glm::vec3(-0.5f), glm::vec3(0.5f)};
+	}
+	AABB box = {glm::vec3(vertices[0], vertices[1], vertices[2]), glm::vec3(vertices[0], vertices[1], vertices[2])};
+	for (size_t i = 9; i + 2 < vertices.size(); i += 9) {
+		glm::vec3 point(vertices[i], vertices[i + 1], vertices[i + 2]);
+		box.min = glm::min(box.min, point);
+		box.max = glm::max(box.max, point);
+	}
+	return box;
 }
 
 std::vector<glm::vec3> Object::getBoundingBoxCorners() const {
-	glm::vec3 minCorner = _position - glm::vec3(0.5f);
-	glm::vec3 maxCorner = _position + glm::vec3(0.5f);
-	
+	// Coins de la boîte locale : la translation est déjà dans la matrice du modèle
+	const glm::vec3 &minCorner = _localAABB.min;
+	const glm::vec3 &maxCorner = _localAABB.max;
+
 	std::vector<glm::vec3> boundingBoxCorners(8);
 	boundingBoxCorners[0] = minCorner;
 	boundingBoxCorners[1] = glm::vec3(minCorner.x, minCorner.y, maxCorner.z);
@@ -188,32 +240,54 @@ std::vector<glm::vec3> Object::getBoundingBoxCorners() const {
 
 	// Appliquer la matrice de transformation à chaque coin.
 	for (auto& corner : boundingBoxCorners) {
-		corner = glm::vec3(_modelMatrix * glm::vec4(corner, 1.0f));
+		corner = glm::vec3(modelMatrix() * glm::vec4(corner, 1.0f));
 	}
 
 	return boundingBoxCorners;
 }
 
+const AABB &Object::getWorldAABB() const {
+	uint32_t version = getTransformVersion();
+	if (version != _worldAABBVersion) {
+		_worldAABB = _localAABB.transformed(_transform.getWorldMatrix());
+		_worldAABBVersion = version;
+	}
+	return _worldAABB;
+}
+
 void Object::update(float dt) {
-	updateModelMatrix();
+	// La matrice et la boîte englobante sont recalculées à la lecture, uniquement quand la transformation a changé
 }
 
-void Object::render(const Shader &shader) const {
+void Object::enqueue(RenderQueue &queue, const Shader &shader) const {
+	if (isInstanced() && isTextured()) {
+		LOG(Error) << getTypeName() << ": instanced objects are drawn by InstancedRenderer";
+		return;
+	}
 	if (!_isMeshSetup) {
 		LOG(Error) << "Mesh is not setup";
 		return;
 	}
 
-	glBindVertexArray(_vao);
+	DrawCommand command;
+	command.shader = &shader;
+	command.vao = _vao;
+	command.model = &modelMatrix();
 
+	// Les faces consécutives de même texture forment un seul appel de dessin
 	unsigned int offset = 0;
 	for (int i = 0; i < 6; ++i) {
-		_facesTextures[i]->use();
-		glDrawElements(GL_TRIANGLES, _numberOfIndicesPerFace[i], GL_UNSIGNED_INT, (void*)(offset * sizeof(unsigned int)));
+		command.texture = isTextured() && _facesTextures[i] ? _facesTextures[i]->getID() : 0;
+		command.offset = offset;
+		command.count = _numberOfIndicesPerFace[i];
 		offset += _numberOfIndicesPerFace[i];
+		while (i + 1 < 6 && _facesTextures[i + 1] == _facesTextures[i]) {
+			++i;
+			command.count += _numberOfIndicesPerFace[i];
+			offset += _numberOfIndicesPerFace[i];
+		}
+		queue.push(command, position());
 	}
-
-	glBindVertexArray(0);
 }
 
 } // namespace Render3D
@@ -11,9 +11,20 @@
 #include "Entity.hpp"
 #include "../../Core/Shader.hpp"
 #include "../../Core/Texture.hpp"
+#include "../../Core/Transform.hpp"
 
 namespace Render3D {
 
+/// @brief Géométrie d'une forme (Cube, Stair, ...) partagée par tous ses objets texturés,
+/// envoyée une seule fois au GPU par InstancedRenderer
+struct ObjectGeometry {
+	std::vector<float> vertices;	// même disposition que Object::setupMesh (36 octets par sommet)
+	std::vector<unsigned int> indices;
+	std::vector<unsigned int> numberOfIndicesPerFace;
+};
+
+using ObjectGeometryPtr = std::shared_ptr<const ObjectGeometry>;
+
 class Object : public Entity {
 public:
 	enum class FormatFile {
@@ -29,6 +40,8 @@ public:
 	Object(const std::string &typeName, const glm::vec3 &position, const std::vector<glm::vec4> &facesColors, const std::vector<float> &vertices, const std::vector<unsigned int> &indices, const std::vector<unsigned int> &numberOfIndicesPerFace);
 	Object(const std::string &typeName, const glm::vec3 &position, const std::array<std::shared_ptr<Texture>, 6> &facesTextures, const std::vector<float> &vertices, const std::vector<unsigned int> &indices, const std::vector<unsigned int> &numberOfIndicesPerFace);
 	Object(const std::string &typeName, const glm::vec3 &position, const std::array<std::shared_ptr<Texture>, 6> &facesTextures, const std::string &filename, FormatFile format);
+	/// @brief Objet texturé sans buffers propres, dessiné par InstancedRenderer avec les autres objets de même géométrie
+	Object(const std::string &typeName, const glm::vec3 &position, const std::array<std::shared_ptr<Texture>, 6> &facesTextures, ObjectGeometryPtr geometry);
 
 	virtual ~Object();
 
@@ -37,6 +50,14 @@ public:
 
 	virtual void setFacesColors(const std::vector<glm::vec4> &facesColors);
 	virtual void setFacesTextures(const std::array<std::shared_ptr<Texture>, 6> &facesTextures);
+	const std::array<std::shared_ptr<Texture>, 6> &getFacesTextures() const;
+	bool isTextured() const;
+
+	/// @brief Géométrie partagée si l'objet est dessiné par instanciation, nullptr sinon
+	ObjectGeometryPtr getGeometry() const;
+	/// @brief L'objet est enregistré dans InstancedRenderer ; il n'y est dessiné que s'il est texturé,
+	/// sinon il passe par enqueue avec ses propres buffers (créés par setFacesColors)
+	bool isInstanced() const override;
 
 	virtual glm::vec3 &position() override;
 	virtual const glm::vec3 &position() const override;
@@ -52,12 +73,19 @@ public:
 	const glm::vec3 &rotateAxis() const override;
 
 	void rotateAxis(const glm::vec3 &axis) override;
+	/// @brief Matrice recalculée à la lecture seulement si l'objet ou son parent a bougé
 	const glm::mat4 &modelMatrix() const override;
+	uint32_t getTransformVersion() const override;
+
+	/// @brief Rattacher l'objet à un parent (nullptr pour le détacher) : position et rotation
+	/// deviennent relatives au parent, qui doit vivre plus longtemps que l'objet
+	void setParent(const Object *parent);
 	
 	virtual std::vector<glm::vec3> getBoundingBoxCorners() const override;
+	virtual const AABB &getWorldAABB() const override;
 
 	virtual void update(float dt) override;
-	virtual void render(const Shader &shader) const override;
+	virtual void enqueue(RenderQueue &queue, const Shader &shader) const override;
 
 protected:
 	void free();
@@ -65,16 +93,26 @@ protected:
 	void setupMesh(std::vector<float> vertices, std::vector<unsigned int> indices, std::vector<unsigned int> numberOfIndicesPerFace);
 
 private:
-	void updateModelMatrix();
+	/// @brief Reporter l'angle et l'axe dans la transformation s'ils ont été modifiés
+	void updateRotation() const;
+
+	/// @brief Boîte englobante des sommets (9 floats par sommet, voir setupMesh)
+	static AABB computeLocalAABB(const std::vector<float> &vertices);
 
 	DrawType _drawType;
 
-	glm::vec3 _position;
+	// Les accesseurs non constants (angle(), rotateAxis()) permettent d'écrire sans setter :
+	// la rotation est marquée modifiée et reportée dans _transform à la prochaine lecture
+	mutable Transform _transform;
 	float _angle;
 	glm::vec3 _rotateAxis;
-	glm::mat4 _modelMatrix;
+	mutable bool _rotationDirty;
+	AABB _localAABB = {glm::vec3(-0.5f), glm::vec3(0.5f)};
+	mutable AABB _worldAABB;
+	mutable uint32_t _worldAABBVersion;	// version de la transformation utilisée pour _worldAABB
 	std::vector<glm::vec4> _facesColor;
 	std::array<std::shared_ptr<Texture>, 6> _facesTextures;
+	ObjectGeometryPtr _geometry;
 	GLuint _vao, _vbo, _ebo;
 	std::vector<unsigned int> _numberOfIndicesPerFace;
 	bool _isMeshSetup;
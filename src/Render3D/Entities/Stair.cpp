@@ -7,7 +7,12 @@ Stair::Stair(const glm::vec3 &position, const std::vector<glm::vec4> facesColors
 
 
 Stair::Stair(const glm::vec3 &position, const std::array<std::shared_ptr<Texture>, 6> textures)
-    : Object("Object:Stair", position, textures, STAIR_VERTICES, STAIR_INDICES, STAIR_NUMBER_OF_INDICES_PER_FACE) {}
+    : Object("Object:Stair", position, textures, geometry()) {}
+
+ObjectGeometryPtr Stair::geometry() {
+    static const ObjectGeometryPtr geometry = std::make_shared<ObjectGeometry>(ObjectGeometry{STAIR_VERTICES, STAIR_INDICES, STAIR_NUMBER_OF_INDICES_PER_FACE});
+    return geometry;
+}
 
 std::vector<float> Stair::colorFaces(const std::vector<float> &vertices, const std::vector<glm::vec4> &facesColors) {
     // Copiez le vecteur d'entrée pour modification
@@ -183,6 +183,9 @@ public:
 	Stair(const glm::vec3 &position, const std::vector<glm::vec4> facesColors);
 	Stair(const glm::vec3 &position, const std::array<std::shared_ptr<Texture>, 6> textures);
 
+	/// @brief Géométrie commune à tous les objets Stair texturés
+	static ObjectGeometryPtr geometry();
+
 private:
 	std::vector<float> colorFaces(const std::vector<float> &vertices, const std::vector<glm::vec4> &facesColors);
 };
@@ -0,0 +1,120 @@
+#include "EntityRegistry.hpp"
+
+namespace Render3D {
+
+EntityRegistry::EntityRegistry()
+	: _freeList(EntityHandle::INVALID_INDEX) {}
+
+EntityHandle EntityRegistry::add(std::shared_ptr<Entity> entity) {
+	if (!entity) {
+		return EntityHandle();
+	}
+	auto [it, inserted] = _entitySlots.emplace(entity.get(), EntityHandle::INVALID_INDEX);
+	if (!inserted) {
+		return EntityHandle();
+	}
+
+	uint32_t index;
+	if (_freeList != EntityHandle::INVALID_INDEX) {
+		index = _freeList;
+		_freeList = _slots[index].dense;
+	} else {
+		index = static_cast<uint32_t>(_slots.size());
+		_slots.emplace_back();
+	}
+	it->second = index;
+
+	Slot &slot = _slots[index];
+	slot.dense = static_cast<uint32_t>(_entities.size());
+	slot.used = true;
+	_entities.push_back(std::move(entity));
+	_denseToSlot.push_back(index);
+	return EntityHandle{index, slot.generation};
+}
+
+bool EntityRegistry::remove(EntityHandle handle) {
+	if (!contains(handle)) {
+		return false;
+	}
+	Slot &slot = _slots[handle.index];
+	_entitySlots.erase(_entities[slot.dense].get());
+
+	// La dernière entité prend la place de celle supprimée
+	const uint32_t last = static_cast<uint32_t>(_entities.size() - 1);
+	if (slot.dense != last) {
+		_entities[slot.dense] = std::move(_entities[last]);
+		_denseToSlot[slot.dense] = _denseToSlot[last];
+		_slots[_denseToSlot[slot.dense]].dense = slot.dense;
+	}
+	_entities.pop_back();
+	_denseToSlot.pop_back();
+
+	slot.generation++;
+	slot.used = false;
+	slot.dense = _freeList;
+	_freeList = handle.index;
+	return true;
+}
+
+void EntityRegistry::clear() {
+	// Les générations sont gardées pour que les anciens handles restent invalides
+	_freeList = EntityHandle::INVALID_INDEX;
+	for (uint32_t index = static_cast<uint32_t>(_slots.size()); index-- > 0;) {
+		Slot &slot = _slots[index];
+		if (slot.used) {
+			slot.generation++;
+			slot.used = false;
+		}
+		slot.dense = _freeList;
+		_freeList = index;
+	}
+	_entities.clear();
+	_denseToSlot.clear();
+	_entitySlots.clear();
+}
+
+void EntityRegistry::reserve(std::size_t count) {
+	_slots.reserve(count);
+	_entities.reserve(count);
+	_denseToSlot.reserve(count);
+	_entitySlots.reserve(count);
+}
+
+EntityHandle EntityRegistry::find(const Entity *entity) const {
+	auto it = _entitySlots.find(entity);
+	if (it == _entitySlots.end()) {
+		return EntityHandle();
+	}
+	return EntityHandle{it->second, _slots[it->second].generation};
+}
+
+bool EntityRegistry::contains(EntityHandle handle) const {
+	return handle.index < _slots.size() && _slots[handle.index].used && _slots[handle.index].generation == handle.generation;
+}
+
+const std::shared_ptr<Entity> &EntityRegistry::get(EntityHandle handle) const {
+	static const std::shared_ptr<Entity> none;
+	if (!contains(handle)) {
+		return none;
+	}
+	return _entities[_slots[handle.index].dense];
+}
+
+std::size_t EntityRegistry::size() const {
+	return _entities.size();
+}
+
+bool EntityRegistry::empty() const {
+	return _entities.empty();
+}
+
+const std::vector<std::shared_ptr<Entity>> &EntityRegistry::getEntities() const {
+	return _entities;
+}
+
+EntityHandle EntityRegistry::getHandle(std::size_t index) const {
+	uint32_t slot = _denseToSlot[index];
+	return EntityHandle{slot, _slots[slot].generation};
+}
+
+} // namespace Render3D
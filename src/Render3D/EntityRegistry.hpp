@@ -0,0 +1,91 @@
+#ifndef RENDER3D_ENTITY_REGISTRY_HPP
+#define RENDER3D_ENTITY_REGISTRY_HPP
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+#include "Entities/Entity.hpp"
+
+namespace Render3D {
+
+/// @brief Identifiant stable d'une entité de la scène
+/// La génération change à chaque réutilisation de l'emplacement : un ancien handle devient invalide
+struct EntityHandle {
+	static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+	uint32_t index = INVALID_INDEX;
+	uint32_t generation = 0;
+
+	bool isValid() const {
+		return index != INVALID_INDEX;
+	}
+
+	bool operator==(const EntityHandle &other) const {
+		return index == other.index && generation == other.generation;
+	}
+
+	bool operator!=(const EntityHandle &other) const {
+		return !(*this == other);
+	}
+};
+
+/*
+	Slot map des entités de la scène :
+	- les entités sont rangées de façon contiguë (parcours des mises à jour et du rendu)
+	- un handle désigne un emplacement qui retrouve l'entité en O(1), quel que soit son rang
+	- la suppression déplace la dernière entité à la place de celle supprimée (O(1))
+	- les emplacements libres sont chaînés et réutilisés avec une génération incrémentée
+*/
+class EntityRegistry {
+public:
+	EntityRegistry();
+
+	/// @brief Ajouter une entité
+	/// @return Handle invalide si l'entité est nulle ou déjà enregistrée
+	EntityHandle add(std::shared_ptr<Entity> entity);
+	/// @return false si le handle ne désigne plus aucune entité
+	bool remove(EntityHandle handle);
+	void clear();
+	void reserve(std::size_t count);
+
+	/// @brief Handle d'une entité enregistrée (handle invalide sinon)
+	EntityHandle find(const Entity *entity) const;
+	bool contains(EntityHandle handle) const;
+	/// @return nullptr si le handle n'est plus valide
+	const std::shared_ptr<Entity> &get(EntityHandle handle) const;
+
+	std::size_t size() const;
+	bool empty() const;
+	/// @brief Entités rangées de façon contiguë, dans un ordre quelconque
+	const std::vector<std::shared_ptr<Entity>> &getEntities() const;
+	/// @brief Handle de l'entité rangée au rang index de getEntities()
+	EntityHandle getHandle(std::size_t index) const;
+
+	std::vector<std::shared_ptr<Entity>>::const_iterator begin() const {
+		return _entities.begin();
+	}
+
+	std::vector<std::shared_ptr<Entity>>::const_iterator end() const {
+		return _entities.end();
+	}
+
+private:
+	struct Slot {
+		uint32_t generation = 0;
+		uint32_t dense = EntityHandle::INVALID_INDEX;	// rang dans _entities, ou emplacement libre suivant
+		bool used = false;
+	};
+
+	std::vector<Slot> _slots;
+	uint32_t _freeList;
+
+	std::vector<std::shared_ptr<Entity>> _entities;
+	std::vector<uint32_t> _denseToSlot;					// emplacement de chaque entité de _entities
+	std::unordered_map<const Entity *, uint32_t> _entitySlots;	// refuser les doublons, retrouver une entité
+};
+
+} // namespace Render3D
+
+#endif // RENDER3D_ENTITY_REGISTRY_HPP
@@ -3,7 +3,9 @@
 
 #include <glm/glm.hpp>
 #include <cmath>
+#include <vector>
 #include "Plane.hpp"
+#include "AABB.hpp"
 
 namespace Render3D {
 
@@ -46,7 +48,7 @@ struct Frustum {
         nearPlane.a = viewProjMatrix[0][3] + viewProjMatrix[0][2];
         nearPlane.b = viewProjMatrix[1][3] + viewProjMatrix[1][2];
         nearPlane.c = viewProjMatrix[2][3] + viewProjMatrix[2][2];
-        nearPlane.a = viewProjMatrix[3][3] + viewProjMatrix[3][2];
+        nearPlane.d = viewProjMatrix[3][3] + viewProjMatrix[3][2];
 
         // Far clipping plane
         farPlane.a = viewProjMatrix[0][3] - viewProjMatrix[0][2];
@@ -77,6 +79,34 @@ struct Frustum {
         return true;
     }
 
+    /// @brief Test plan / boîte : seul le coin le plus avancé dans la direction de la normale (p-vertex)
+    /// est testé pour chaque plan ; s'il est derrière un plan, toute la boîte l'est
+    bool AABBIsInside(const AABB &box) const {
+        for (const Plane *plane : {&rightPlane, &leftPlane, &topPlane, &bottomPlane, &farPlane, &nearPlane}) {
+            glm::vec3 positive(plane->a >= 0.0f ? box.max.x : box.min.x,
+                               plane->b >= 0.0f ? box.max.y : box.min.y,
+                               plane->c >= 0.0f ? box.max.z : box.min.z);
+            if (plane->DistanceToPoint(positive) < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief Boîte entièrement dans le frustum : le coin le moins avancé (n-vertex) est devant chaque plan
+    /// (permet de ne plus tester les enfants d'un nœud de hiérarchie)
+    bool AABBIsFullyInside(const AABB &box) const {
+        for (const Plane *plane : {&rightPlane, &leftPlane, &topPlane, &bottomPlane, &farPlane, &nearPlane}) {
+            glm::vec3 negative(plane->a >= 0.0f ? box.min.x : box.max.x,
+                               plane->b >= 0.0f ? box.min.y : box.max.y,
+                               plane->c >= 0.0f ? box.min.z : box.max.z);
+            if (plane->DistanceToPoint(negative) < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     bool PointsAreInside(const std::vector<glm::vec3>& points) const {
         for (const auto& point : points) {
             if (!PointIsInside(point)) {
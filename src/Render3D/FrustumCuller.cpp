@@ -0,0 +1,204 @@
+#include "FrustumCuller.hpp"
+#include <bitset>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define FRUSTUM_CULLER_X86
+#include <immintrin.h>
+#endif
+
+namespace Render3D {
+
+namespace {
+
+/// @brief Plans du frustum sous forme de tableaux : normale, |normale| (pour le rayon projeté) et distance
+struct PlaneSet {
+	float a[6], b[6], c[6], d[6];
+	float absA[6], absB[6], absC[6];
+
+	PlaneSet(const Frustum &frustum) {
+		const Plane *planes[6] = {&frustum.rightPlane, &frustum.leftPlane, &frustum.topPlane,
+								  &frustum.bottomPlane, &frustum.farPlane, &frustum.nearPlane};
+		for (int i = 0; i < 6; ++i) {
+			a[i] = planes[i]->a;
+			b[i] = planes[i]->b;
+			c[i] = planes[i]->c;
+			d[i] = planes[i]->d;
+			absA[i] = std::abs(a[i]);
+			absB[i] = std::abs(b[i]);
+			absC[i] = std::abs(c[i]);
+		}
+	}
+};
+
+/*
+	Une boîte (centre C, demi-côtés E) est hors du frustum si, pour un plan (N, d),
+	N.C + d + |N|.E < 0 : c'est le test du p-vertex de Frustum::AABBIsInside sans branchement
+*/
+
+void cullScalar(const PlaneSet &planes, const float *cx, const float *cy, const float *cz,
+				const float *ex, const float *ey, const float *ez, std::size_t count, uint64_t *words) {
+	for (std::size_t i = 0; i < count; ++i) {
+		bool visible = true;
+		for (int p = 0; p < 6 && visible; ++p) {
+			float distance = planes.a[p] * cx[i] + planes.b[p] * cy[i] + planes.c[p] * cz[i] + planes.d[p];
+			float radius = planes.absA[p] * ex[i] + planes.absB[p] * ey[i] + planes.absC[p] * ez[i];
+			visible = distance + radius >= 0.0f;
+		}
+		if (visible) {
+			words[i >> 6] |= uint64_t(1) << (i & 63);
+		}
+	}
+}
+
+#ifdef FRUSTUM_CULLER_X86
+
+void cullSSE(const PlaneSet &planes, const float *cx, const float *cy, const float *cz,
+			 const float *ex, const float *ey, const float *ez, std::size_t count, uint64_t *words) {
+	const __m128 zero = _mm_setzero_ps();
+	for (std::size_t i = 0; i < count; i += 4) {
+		__m128 x = _mm_loadu_ps(cx + i), y = _mm_loadu_ps(cy + i), z = _mm_loadu_ps(cz + i);
+		__m128 sx = _mm_loadu_ps(ex + i), sy = _mm_loadu_ps(ey + i), sz = _mm_loadu_ps(ez + i);
+		__m128 inside = _mm_cmpeq_ps(zero, zero);
+		for (int p = 0; p < 6; ++p) {
+			__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.a[p]), x),
+													_mm_mul_ps(_mm_set1_ps(planes.b[p]), y)),
+										 _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.c[p]), z),
+													_mm_set1_ps(planes.d[p])));
+			__m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.absA[p]), sx),
+												  _mm_mul_ps(_mm_set1_ps(planes.absB[p]), sy)),
+									   _mm_mul_ps(_mm_set1_ps(planes.absC[p]), sz));
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+		}
+		words[i >> 6] |= uint64_t(_mm_movemask_ps(inside)) << (i & 63);
+	}
+}
+
+// Compilé pour AVX même si le reste du programme ne l'est pas, appelé seulement si le processeur le supporte
+__attribute__((target("avx")))
+void cullAVX(const PlaneSet &planes, const float *cx, const float *cy, const float *cz,
+			 const float *ex, const float *ey, const float *ez, std::size_t count, uint64_t *words) {
+	const __m256 zero = _mm256_setzero_ps();
+	for (std::size_t i = 0; i < count; i += 8) {
+		__m256 x = _mm256_loadu_ps(cx + i), y = _mm256_loadu_ps(cy + i), z = _mm256_loadu_ps(cz + i);
+		__m256 sx = _mm256_loadu_ps(ex + i), sy = _mm256_loadu_ps(ey + i), sz = _mm256_loadu_ps(ez + i);
+		__m256 inside = _mm256_cmp_ps(zero, zero, _CMP_EQ_OQ);
+		for (int p = 0; p < 6; ++p) {
+			__m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.a[p]), x),
+														  _mm256_mul_ps(_mm256_set1_ps(planes.b[p]), y)),
+											_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.c[p]), z),
+														  _mm256_set1_ps(planes.d[p])));
+			__m256 radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.absA[p]), sx),
+														_mm256_mul_ps(_mm256_set1_ps(planes.absB[p]), sy)),
+										  _mm256_mul_ps(_mm256_set1_ps(planes.absC[p]), sz));
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_GE_OQ));
+		}
+		words[i >> 6] |= uint64_t(_mm256_movemask_ps(inside)) << (i & 63);
+	}
+}
+
+#endif // FRUSTUM_CULLER_X86
+
+} // namespace
+
+/* - - - - - - - - - - - - - - - - - - - - */
+
+std::size_t FrustumCuller::add(const AABB &box) {
+	if (_count == paddedSize()) {
+		// Les boîtes de remplissage (nulles) sont testées puis effacées du masque
+		for (auto *values : {&_centerX, &_centerY, &_centerZ, &_extentX, &_extentY, &_extentZ}) {
+			values->resize(_count + 8, 0.0f);
+		}
+	}
+	set(_count, box);
+	return _count++;
+}
+
+void FrustumCuller::set(std::size_t index, const AABB &box) {
+	glm::vec3 center = box.getCenter();
+	glm::vec3 extents = box.getExtents();
+	_centerX[index] = center.x;
+	_centerY[index] = center.y;
+	_centerZ[index] = center.z;
+	_extentX[index] = extents.x;
+	_extentY[index] = extents.y;
+	_extentZ[index] = extents.z;
+}
+
+void FrustumCuller::clear() {
+	for (auto *values : {&_centerX, &_centerY, &_centerZ, &_extentX, &_extentY, &_extentZ}) {
+		values->clear();
+	}
+	_count = 0;
+}
+
+void FrustumCuller::reserve(std::size_t count) {
+	for (auto *values : {&_centerX, &_centerY, &_centerZ, &_extentX, &_extentY, &_extentZ}) {
+		values->reserve((count + 7) & ~std::size_t(7));
+	}
+}
+
+std::size_t FrustumCuller::size() const {
+	return _count;
+}
+
+std::size_t FrustumCuller::paddedSize() const {
+	return _centerX.size();
+}
+
+/* - - - - - - - - - - - - - - - - - - - - */
+
+FrustumCuller::Path FrustumCuller::getBestPath() {
+#ifdef FRUSTUM_CULLER_X86
+	static const Path best = __builtin_cpu_supports("avx") ? Path::AVX : Path::SSE;
+	return best;
+#else
+	return Path::Scalar;
+#endif
+}
+
+const char *FrustumCuller::getPathName(Path path) {
+	switch (path) {
+		case Path::AVX: return "AVX";
+		case Path::SSE: return "SSE";
+		default: return "scalar";
+	}
+}
+
+std::size_t FrustumCuller::cull(const Frustum &frustum, std::vector<uint64_t> &visibility) const {
+	return cull(frustum, visibility, getBestPath());
+}
+
+std::size_t FrustumCuller::cull(const Frustum &frustum, std::vector<uint64_t> &visibility, Path path) const {
+	visibility.assign((paddedSize() + 63) / 64, 0);
+	if (_count == 0) {
+		return 0;
+	}
+
+	PlaneSet planes(frustum);
+	const float *data[6] = {_centerX.data(), _centerY.data(), _centerZ.data(),
+							_extentX.data(), _extentY.data(), _extentZ.data()};
+
+#ifdef FRUSTUM_CULLER_X86
+	if (path == Path::AVX && getBestPath() == Path::AVX) {
+		cullAVX(planes, data[0], data[1], data[2], data[3], data[4], data[5], paddedSize(), visibility.data());
+	} else if (path != Path::Scalar) {
+		cullSSE(planes, data[0], data[1], data[2], data[3], data[4], data[5], paddedSize(), visibility.data());
+	} else
+#endif
+	{
+		cullScalar(planes, data[0], data[1], data[2], data[3], data[4], data[5], _count, visibility.data());
+	}
+
+	// Effacer les bits des boîtes de remplissage
+	if (_count & 63) {
+		visibility[_count >> 6] &= (uint64_t(1) << (_count & 63)) - 1;
+	}
+
+	std::size_t visible = 0;
+	for (uint64_t word : visibility) {
+		visible += std::bitset<64>(word).count();
+	}
+	return visible;
+}
+
+} // namespace Render3D
@@ -0,0 +1,58 @@
+#ifndef RENDER3D_FRUSTUM_CULLER_HPP
+#define RENDER3D_FRUSTUM_CULLER_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "AABB.hpp"
+#include "Frustum.hpp"
+
+namespace Render3D {
+
+/// @brief Test de visibilité d'un grand nombre de boîtes contre les 6 plans du frustum
+/// Les centres et demi-côtés sont rangés en tableaux séparés (SoA) pour tester 8 boîtes (AVX)
+/// ou 4 boîtes (SSE) par itération ; la version scalaire sert de repli et de référence
+class FrustumCuller {
+public:
+	enum class Path {
+		Scalar,
+		SSE,
+		AVX
+	};
+
+	/// @brief Ajouter une boîte
+	/// @return Indice de la boîte (bit correspondant dans le masque de visibilité)
+	std::size_t add(const AABB &box);
+	/// @brief Remplacer la boîte d'indice index
+	void set(std::size_t index, const AABB &box);
+	void clear();
+	void reserve(std::size_t count);
+	std::size_t size() const;
+
+	/// @brief Tester toutes les boîtes avec le meilleur jeu d'instructions disponible
+	/// @param visibility Masque de sortie, bit i de visibility[i / 64] à 1 si la boîte i est visible
+	/// @return Nombre de boîtes visibles
+	std::size_t cull(const Frustum &frustum, std::vector<uint64_t> &visibility) const;
+	/// @brief Même test en imposant le chemin (Path::AVX ou Path::SSE retombent sur le scalaire si non supportés)
+	std::size_t cull(const Frustum &frustum, std::vector<uint64_t> &visibility, Path path) const;
+
+	/// @brief Chemin choisi par cull() sur ce processeur
+	static Path getBestPath();
+	static const char *getPathName(Path path);
+
+	static bool isVisible(const std::vector<uint64_t> &visibility, std::size_t index) {
+		return (visibility[index >> 6] >> (index & 63)) & 1;
+	}
+
+private:
+	/// @brief Nombre de boîtes arrondi au multiple de 8 : les boucles SIMD n'ont pas de reste à traiter
+	std::size_t paddedSize() const;
+
+	std::vector<float> _centerX, _centerY, _centerZ;
+	std::vector<float> _extentX, _extentY, _extentZ;
+	std::size_t _count = 0;
+};
+
+} // namespace Render3D
+
+#endif // RENDER3D_FRUSTUM_CULLER_HPP
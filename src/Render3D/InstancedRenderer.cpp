@@ -0,0 +1,272 @@
+#include "InstancedRenderer.hpp"
+#include <algorithm>
+#include "../Core/Logger.hpp"
+
+namespace Render3D {
+
+InstancedRenderer::InstancedRenderer()
+	: _defaultLayer(0), _texturesDirty(false) {
+}
+
+InstancedRenderer::~InstancedRenderer() {
+	clear();
+}
+
+void InstancedRenderer::add(std::shared_ptr<Object> object) {
+	ObjectGeometryPtr geometry = object->getGeometry();
+	if (!geometry) {
+		LOG(Error) << object->getTypeName() << ": object has no shared geometry to instance";
+		return;
+	}
+
+	auto it = _batches.find(geometry.get());
+	if (it == _batches.end()) {
+		it = _batches.emplace(geometry.get(), Batch()).first;
+		setupBatch(it->second, *geometry);
+		_geometries.push_back(geometry);
+	}
+	Batch &batch = it->second;
+	if (!batch.objectIndices.emplace(object.get(), batch.objects.size()).second) {
+		return;
+	}
+	batch.objects.push_back(object);
+	batch.models.push_back(object->modelMatrix());
+	if (!_textureArray.isLoaded()) {
+		_texturesDirty = true;	// au moins la couche par défaut, même si l'objet n'a aucune texture
+	}
+
+	for (const auto &texture : object->getFacesTextures()) {
+		if (texture) {
+			getLayer(texture);
+		}
+	}
+}
+
+void InstancedRenderer::remove(std::shared_ptr<Object> object) {
+	ObjectGeometryPtr geometry = object->getGeometry();
+	if (!geometry) {
+		return;
+	}
+	auto it = _batches.find(geometry.get());
+	if (it == _batches.end()) {
+		return;
+	}
+	Batch &batch = it->second;
+	auto index = batch.objectIndices.find(object.get());
+	if (index == batch.objectIndices.end()) {
+		return;
+	}
+	// Le dernier objet prend la place de celui retiré : l'ordre des instances n'a pas d'importance
+	if (index->second != batch.objects.size() - 1) {
+		batch.objects[index->second] = std::move(batch.objects.back());
+		batch.models[index->second] = batch.models.back();
+		batch.objectIndices[batch.objects[index->second].get()] = index->second;
+	}
+	batch.objects.pop_back();
+	batch.models.pop_back();
+	batch.objectIndices.erase(index);
+
+	// Les textures restent dans le tableau : elles seront probablement réutilisées
+	if (batch.objects.empty()) {
+		freeBatch(it->second);
+		_batches.erase(it);
+		_geometries.erase(std::remove(_geometries.begin(), _geometries.end(), geometry), _geometries.end());
+	}
+}
+
+void InstancedRenderer::refresh(const Object &object) {
+	auto it = _batches.find(object.getGeometry().get());
+	if (it == _batches.end()) {
+		return;
+	}
+	auto index = it->second.objectIndices.find(&object);
+	if (index != it->second.objectIndices.end()) {
+		it->second.models[index->second] = object.modelMatrix();
+	}
+}
+
+void InstancedRenderer::clear() {
+	for (auto &[geometry, batch] : _batches) {
+		freeBatch(batch);
+	}
+	_batches.clear();
+	_geometries.clear();
+	_textures.clear();
+	_layers.clear();
+	_missingTextures.clear();
+	_textureArray.free();
+	_texturesDirty = false;
+}
+
+unsigned int InstancedRenderer::getLayer(const TexturePtr &texture) {
+	auto it = _layers.find(texture.get());
+	if (it != _layers.end()) {
+		return it->second;
+	}
+	unsigned int layer = _textures.size();
+	_textures.push_back(texture);
+	_layers[texture.get()] = layer;
+	_texturesDirty = true;
+	return layer;
+}
+
+unsigned int InstancedRenderer::findLayer(const TexturePtr &texture) const {
+	if (!texture) {
+		return _defaultLayer;
+	}
+	auto it = _layers.find(texture.get());
+	if (it == _layers.end()) {
+		_missingTextures.push_back(texture);
+		return _defaultLayer;
+	}
+	return it->second;
+}
+
+void InstancedRenderer::setupBatch(Batch &batch, const ObjectGeometry &geometry) {
+	// Face de chaque sommet, retrouvée à partir des plages d'indices de chaque face
+	std::vector<unsigned char> faces(geometry.vertices.size() / 9, 0);
+	unsigned int offset = 0;
+	for (unsigned int face = 0; face < geometry.numberOfIndicesPerFace.size(); ++face) {
+		for (unsigned int i = 0; i < geometry.numberOfIndicesPerFace[face]; ++i) {
+			faces[geometry.indices[offset + i]] = face;
+		}
+		offset += geometry.numberOfIndicesPerFace[face];
+	}
+	batch.indexCount = geometry.indices.size();
+
+	glGenVertexArrays(1, &batch.vao);
+	glGenBuffers(1, &batch.vbo);
+	glGenBuffers(1, &batch.faceVbo);
+	glGenBuffers(1, &batch.ebo);
+	glGenBuffers(1, &batch.instanceVbo);
+
+	glBindVertexArray(batch.vao);
+
+	// Même disposition que Object::setupMesh (stride de 36 octets)
+	glBindBuffer(GL_ARRAY_BUFFER, batch.vbo);
+	glBufferData(GL_ARRAY_BUFFER, geometry.vertices.size() * sizeof(float), geometry.vertices.data(), GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 36, (void*)(0));
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 36, (void*)(12));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 36, (void*)(28));
+	glEnableVertexAttribArray(2);
+
+	glBindBuffer(GL_ARRAY_BUFFER, batch.faceVbo);
+	glBufferData(GL_ARRAY_BUFFER, faces.size(), faces.data(), GL_STATIC_DRAW);
+	glVertexAttribIPointer(3, 1, GL_UNSIGNED_BYTE, 1, (void*)(0));
+	glEnableVertexAttribArray(3);
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch.ebo);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, geometry.indices.size() * sizeof(unsigned int), geometry.indices.data(), GL_STATIC_DRAW);
+
+	// Attributs par instance : la matrice occupe 4 emplacements (une colonne chacun)
+	glBindBuffer(GL_ARRAY_BUFFER, batch.instanceVbo);
+	for (unsigned int column = 0; column < 4; ++column) {
+		glVertexAttribPointer(4 + column, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)(column * sizeof(glm::vec4)));
+		glEnableVertexAttribArray(4 + column);
+		glVertexAttribDivisor(4 + column, 1);
+	}
+	glVertexAttribIPointer(8, 3, GL_UNSIGNED_INT, sizeof(Instance), (void*)(sizeof(glm::mat4)));
+	glEnableVertexAttribArray(8);
+	glVertexAttribDivisor(8, 1);
+
+	glBindVertexArray(0);
+}
+
+void InstancedRenderer::freeBatch(Batch &batch) {
+	glDeleteVertexArrays(1, &batch.vao);
+	glDeleteBuffers(1, &batch.vbo);
+	glDeleteBuffers(1, &batch.faceVbo);
+	glDeleteBuffers(1, &batch.ebo);
+	glDeleteBuffers(1, &batch.instanceVbo);
+	batch.vao = batch.vbo = batch.faceVbo = batch.ebo = batch.instanceVbo = 0;
+}
+
+void InstancedRenderer::update() {
+	for (const auto &texture : _missingTextures) {
+		getLayer(texture);
+	}
+	_missingTextures.clear();
+
+	if (_texturesDirty) {
+		// La couche blanche est ajoutée après les autres : la taille du tableau reste celle de la première texture
+		if (!_defaultTexture) {
+			_defaultTexture = std::make_shared<Texture>(glm::ivec2(1, 1), std::vector<glm::vec4>{glm::vec4(1.0f)});
+		}
+		std::vector<TexturePtr> layers = _textures;
+		layers.push_back(_defaultTexture);
+		_defaultLayer = _textures.size();
+		if (!_textureArray.createFromTextures(layers)) {
+			LOG(Error) << "Failed to build the instanced objects texture array";
+		}
+		_texturesDirty = false;
+	}
+}
+
+void InstancedRenderer::enqueue(RenderQueue &queue, const Shader &shader, const std::vector<const Object *> &visibleObjects) const {
+	if (!_textureArray.isLoaded()) {
+		return;
+	}
+
+	for (const auto &[geometry, batch] : _batches) {
+		batch.instances.clear();
+	}
+	for (const Object *object : visibleObjects) {
+		auto it = _batches.find(object->getGeometry().get());
+		if (it == _batches.end()) {
+			continue;
+		}
+		Instance instance;
+		if (object->isStatic()) {
+			auto index = it->second.objectIndices.find(object);
+			instance.model = it->second.models[index->second];
+		} else {
+			instance.model = object->modelMatrix();
+		}
+		const auto &textures = object->getFacesTextures();
+		for (unsigned int k = 0; k < 3; ++k) {
+			instance.layers[k] = findLayer(textures[2 * k]) | (findLayer(textures[2 * k + 1]) << 16);
+		}
+		it->second.instances.push_back(instance);
+	}
+
+	for (const auto &[geometry, batch] : _batches) {
+		if (batch.instances.empty()) {
+			continue;
+		}
+
+		// Le buffer n'est réalloué que lorsqu'il devient trop petit
+		glBindBuffer(GL_ARRAY_BUFFER, batch.instanceVbo);
+		if (batch.instances.size() > batch.instanceCapacity) {
+			batch.instanceCapacity = batch.instances.size();
+			glBufferData(GL_ARRAY_BUFFER, batch.instanceCapacity * sizeof(Instance), batch.instances.data(), GL_DYNAMIC_DRAW);
+		} else {
+			glBufferSubData(GL_ARRAY_BUFFER, 0, batch.instances.size() * sizeof(Instance), batch.instances.data());
+		}
+
+		DrawCommand command;
+		command.shader = &shader;
+		command.textureTarget = GL_TEXTURE_2D_ARRAY;
+		command.texture = _textureArray.getID();
+		command.vao = batch.vao;
+		command.count = batch.indexCount;
+		command.instances = batch.instances.size();
+		queue.push(command, batch.objects.front()->position());
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+size_t InstancedRenderer::getBatchCount() const {
+	return _batches.size();
+}
+
+size_t InstancedRenderer::getInstanceCount() const {
+	size_t count = 0;
+	for (const auto &[geometry, batch] : _batches) {
+		count += batch.objects.size();
+	}
+	return count;
+}
+
+} // namespace Render3D
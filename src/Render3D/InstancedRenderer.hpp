@@ -0,0 +1,91 @@
+#ifndef RENDER3D_INSTANCED_RENDERER_HPP
+#define RENDER3D_INSTANCED_RENDERER_HPP
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include "../Core/Shader.hpp"
+#include "../Core/TextureArray.hpp"
+#include "Entities/Object.hpp"
+#include "RenderQueue.hpp"
+
+namespace Render3D {
+
+/// @brief Dessine tous les objets d'une même géométrie (Cube, Stair, InnerStair, ...) en un seul appel
+/// La géométrie est envoyée une fois, la matrice et les textures de chaque objet vont dans un buffer d'instances
+class InstancedRenderer {
+public:
+	InstancedRenderer();
+	~InstancedRenderer();
+
+	InstancedRenderer(const InstancedRenderer &) = delete;
+	InstancedRenderer &operator=(const InstancedRenderer &) = delete;
+
+	/// @brief Ajouter un objet instancié (Object::isInstanced)
+	void add(std::shared_ptr<Object> object);
+	void remove(std::shared_ptr<Object> object);
+	/// @brief Recopier la matrice d'un objet statique déplacé (les objets dynamiques sont relus à chaque image)
+	void refresh(const Object &object);
+	void clear();
+
+	/// @brief Reconstruire le tableau de textures si de nouvelles textures ont été ajoutées
+	/// (y compris celles données à un objet par setFacesTextures après son ajout)
+	void update();
+
+	/// @brief Recopier les objets visibles (déjà passés au frustum par la scène) dans les buffers
+	/// d'instances puis ajouter un appel glDrawElementsInstanced par géométrie
+	/// Une face sans texture, ou dont la texture n'est pas encore dans le tableau, utilise la couche
+	/// blanche par défaut ; la texture est ajoutée au prochain update
+	void enqueue(RenderQueue &queue, const Shader &shader, const std::vector<const Object *> &visibleObjects) const;
+
+	/// @brief Nombre de géométries distinctes (donc d'appels de dessin)
+	size_t getBatchCount() const;
+	size_t getInstanceCount() const;
+
+private:
+	/*
+		Données d'une instance (76 octets) : matrice du modèle puis couche de texture de chaque face,
+		deux couches de 16 bits par entier (face 2k dans les bits bas, face 2k+1 dans les bits hauts)
+	*/
+	struct Instance {
+		glm::mat4 model;
+		uint32_t layers[3];
+	};
+
+	struct Batch {
+		GLuint vao = 0, vbo = 0, faceVbo = 0, ebo = 0, instanceVbo = 0;
+		unsigned int indexCount = 0;
+		std::vector<std::shared_ptr<Object>> objects;
+		std::unordered_map<const Object *, size_t> objectIndices;	// rang dans objects, pour retirer en O(1)
+		std::vector<glm::mat4> models;		// matrices des objets, calculées une fois pour les objets statiques
+		// Instances visibles de l'image en cours, remplies pendant enqueue
+		mutable std::vector<Instance> instances;
+		mutable size_t instanceCapacity = 0;
+	};
+
+	void setupBatch(Batch &batch, const ObjectGeometry &geometry);
+	void freeBatch(Batch &batch);
+
+	/// @brief Couche de la texture dans le tableau de textures (ajoutée si nouvelle)
+	unsigned int getLayer(const TexturePtr &texture);
+	/// @brief Couche de la texture, couche par défaut si elle est nulle ou pas encore ajoutée
+	unsigned int findLayer(const TexturePtr &texture) const;
+
+	std::unordered_map<const ObjectGeometry *, Batch> _batches;
+	std::vector<ObjectGeometryPtr> _geometries;	// garde les géométries en vie tant que leur batch existe
+
+	std::vector<TexturePtr> _textures;
+	std::unordered_map<const Texture *, unsigned int> _layers;
+	TextureArray _textureArray;
+	TexturePtr _defaultTexture;		// blanc, dernière couche du tableau
+	unsigned int _defaultLayer;
+	mutable std::vector<TexturePtr> _missingTextures;	// rencontrées pendant enqueue, ajoutées par update
+	bool _texturesDirty;
+};
+
+} // namespace Render3D
+
+#endif // RENDER3D_INSTANCED_RENDERER_HPP
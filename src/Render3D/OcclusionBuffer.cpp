@@ -0,0 +1,242 @@
+#include "OcclusionBuffer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#if defined(__SSE2__)
+#define OCCLUSION_BUFFER_SSE
+#include <emmintrin.h>
+#endif
+
+namespace Render3D {
+
+// Marge relative en faveur de la visibilité (erreurs d'arrondi entre une face et la boîte qui la contient)
+static const float DEPTH_BIAS = 1.0e-3f;
+
+OcclusionBuffer::OcclusionBuffer(int width, int height)
+	: _width((std::max(width, 4) + 3) & ~3), _height(std::max(height, 1)),
+	  _depth(_width * _height, 0.0f), _viewProjMatrix(1.0f), _quadCount(0) {}
+
+void OcclusionBuffer::clear(const glm::mat4 &viewProjMatrix) {
+	std::fill(_depth.begin(), _depth.end(), 0.0f);
+	_viewProjMatrix = viewProjMatrix;
+	_quadCount = 0;
+}
+
+bool OcclusionBuffer::project(const glm::vec3 &point, glm::vec3 &screen) const {
+	glm::vec4 clip = _viewProjMatrix * glm::vec4(point, 1.0f);
+	// Plan proche d'OpenGL : z >= -w (implique w > 0)
+	if (clip.z < -clip.w || clip.w <= 0.0f) {
+		return false;
+	}
+	float inverseW = 1.0f / clip.w;
+	screen.x = (clip.x * inverseW * 0.5f + 0.5f) * _width;
+	screen.y = (clip.y * inverseW * 0.5f + 0.5f) * _height;
+	screen.z = inverseW;
+	return true;
+}
+
+bool OcclusionBuffer::drawQuad(const glm::vec3 (&corners)[4]) {
+	glm::vec3 screen[4];
+	for (int i = 0; i < 4; ++i) {
+		if (!project(corners[i], screen[i])) {
+			return false;
+		}
+	}
+	drawConvexQuad(screen);
+	return true;
+}
+
+bool OcclusionBuffer::drawRectangle(const AABB &rectangle) {
+	// Axe plat = normale, les deux autres décrivent le rectangle
+	int normal = 0;
+	glm::vec3 size = rectangle.max - rectangle.min;
+	if (size.y <= size[normal]) normal = 1;
+	if (size.z <= size[normal]) normal = 2;
+	const int u = (normal + 1) % 3;
+	const int v = (normal + 2) % 3;
+
+	glm::vec3 corners[4] = {rectangle.min, rectangle.min, rectangle.min, rectangle.min};
+	corners[1][u] = rectangle.max[u];
+	corners[2][u] = rectangle.max[u];
+	corners[2][v] = rectangle.max[v];
+	corners[3][v] = rectangle.max[v];
+	return drawQuad(corners);
+}
+
+void OcclusionBuffer::drawConvexQuad(glm::vec3 (&quad)[4]) {
+	// Double de l'aire signée (formule du lacet)
+	float area = 0.0f;
+	for (int i = 0; i < 4; ++i) {
+		const glm::vec3 &p = quad[i], &q = quad[(i + 1) & 3];
+		area += p.x * q.y - q.x * p.y;
+	}
+	if (std::abs(area) < 1.0e-6f) {
+		return;
+	}
+	// Sens direct pour que l'intérieur ait les quatre fonctions d'arête positives (faces avant et arrière dessinées)
+	if (area < 0.0f) {
+		std::swap(quad[1], quad[3]);
+	}
+
+	int minX = std::max(0, static_cast<int>(std::floor(std::min({quad[0].x, quad[1].x, quad[2].x, quad[3].x}))));
+	int maxX = std::min(_width - 1, static_cast<int>(std::floor(std::max({quad[0].x, quad[1].x, quad[2].x, quad[3].x}))));
+	int minY = std::max(0, static_cast<int>(std::floor(std::min({quad[0].y, quad[1].y, quad[2].y, quad[3].y}))));
+	int maxY = std::min(_height - 1, static_cast<int>(std::floor(std::max({quad[0].y, quad[1].y, quad[2].y, quad[3].y}))));
+	if (minX > maxX || minY > maxY) {
+		return;
+	}
+	_quadCount++;
+
+	/*
+		Rastérisation conservatrice : un pixel n'est écrit que si le quad le couvre entièrement.
+		Fonction d'arête (p, q) au point (x, y) : (q.x - p.x) * (y - p.y) - (q.y - p.y) * (x - p.x),
+		elle varie de stepX[i] par pixel vers la droite et de stepY[i] par ligne. Sa valeur au coin
+		du pixel qui la minimise est celle du centre moins (|stepX| + |stepY|) / 2 : si elle est positive
+		pour les quatre arêtes, tout le pixel est dans le quad (convexe).
+		Le pixel étant entièrement dans le quad, on y écrit de même le plus petit 1/w du pixel (le plus lointain).
+	*/
+	float stepX[4], stepY[4], origin[4];
+	const float startX = static_cast<float>(minX & ~3) + 0.5f;
+	const float startY = static_cast<float>(minY) + 0.5f;
+	for (int i = 0; i < 4; ++i) {
+		const glm::vec3 &p = quad[i], &q = quad[(i + 1) & 3];
+		stepX[i] = -(q.y - p.y);
+		stepY[i] = q.x - p.x;
+		origin[i] = (q.x - p.x) * (startY - p.y) - (q.y - p.y) * (startX - p.x)
+				  - 0.5f * (std::abs(stepX[i]) + std::abs(stepY[i]));
+	}
+
+	// 1/w est linéaire sur l'écran et les quatre coins sont coplanaires : le plan est pris
+	// sur le plus grand des deux triangles (l'autre peut être presque plat)
+	const glm::vec3 &a = quad[0];
+	const float area012 = (quad[1].x - a.x) * (quad[2].y - a.y) - (quad[1].y - a.y) * (quad[2].x - a.x);
+	const float area023 = (quad[2].x - a.x) * (quad[3].y - a.y) - (quad[2].y - a.y) * (quad[3].x - a.x);
+	const glm::vec3 &b = std::abs(area012) >= std::abs(area023) ? quad[1] : quad[2];
+	const glm::vec3 &c = std::abs(area012) >= std::abs(area023) ? quad[2] : quad[3];
+	const float inverseArea = 1.0f / ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x));
+	const float depthStepX = ((b.z - a.z) * (c.y - a.y) - (c.z - a.z) * (b.y - a.y)) * inverseArea;
+	const float depthStepY = ((c.z - a.z) * (b.x - a.x) - (b.z - a.z) * (c.x - a.x)) * inverseArea;
+	const float depthOrigin = a.z + depthStepX * (startX - a.x) + depthStepY * (startY - a.y)
+							- 0.5f * (std::abs(depthStepX) + std::abs(depthStepY));
+
+	for (int y = minY; y <= maxY; ++y) {
+		const float dy = static_cast<float>(y - minY);
+		float e0 = origin[0] + stepY[0] * dy;
+		float e1 = origin[1] + stepY[1] * dy;
+		float e2 = origin[2] + stepY[2] * dy;
+		float e3 = origin[3] + stepY[3] * dy;
+		float depth = depthOrigin + depthStepY * dy;
+		float *row = &_depth[y * _width];
+
+		// Les groupes de 4 commencent sur un multiple de 4 : _width l'étant aussi, aucun ne déborde de la ligne
+		int x = minX & ~3;
+#ifdef OCCLUSION_BUFFER_SSE
+		const __m128 lanes = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+		const __m128 zero = _mm_setzero_ps();
+		__m128 edge0 = _mm_add_ps(_mm_set1_ps(e0), _mm_mul_ps(_mm_set1_ps(stepX[0]), lanes));
+		__m128 edge1 = _mm_add_ps(_mm_set1_ps(e1), _mm_mul_ps(_mm_set1_ps(stepX[1]), lanes));
+		__m128 edge2 = _mm_add_ps(_mm_set1_ps(e2), _mm_mul_ps(_mm_set1_ps(stepX[2]), lanes));
+		__m128 edge3 = _mm_add_ps(_mm_set1_ps(e3), _mm_mul_ps(_mm_set1_ps(stepX[3]), lanes));
+		__m128 depths = _mm_add_ps(_mm_set1_ps(depth), _mm_mul_ps(_mm_set1_ps(depthStepX), lanes));
+		const __m128 edgeStep0 = _mm_set1_ps(stepX[0] * 4.0f);
+		const __m128 edgeStep1 = _mm_set1_ps(stepX[1] * 4.0f);
+		const __m128 edgeStep2 = _mm_set1_ps(stepX[2] * 4.0f);
+		const __m128 edgeStep3 = _mm_set1_ps(stepX[3] * 4.0f);
+		const __m128 depthStep = _mm_set1_ps(depthStepX * 4.0f);
+		for (; x <= maxX; x += 4) {
+			__m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(edge0, zero), _mm_cmpge_ps(edge1, zero)),
+									   _mm_and_ps(_mm_cmpge_ps(edge2, zero), _mm_cmpge_ps(edge3, zero)));
+			if (_mm_movemask_ps(inside)) {
+				__m128 current = _mm_loadu_ps(row + x);
+				__m128 nearest = _mm_max_ps(current, depths);
+				_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+			}
+			edge0 = _mm_add_ps(edge0, edgeStep0);
+			edge1 = _mm_add_ps(edge1, edgeStep1);
+			edge2 = _mm_add_ps(edge2, edgeStep2);
+			edge3 = _mm_add_ps(edge3, edgeStep3);
+			depths = _mm_add_ps(depths, depthStep);
+		}
+#else
+		for (; x <= maxX; ++x) {
+			if (e0 >= 0.0f && e1 >= 0.0f && e2 >= 0.0f && e3 >= 0.0f) {
+				row[x] = std::max(row[x], depth);
+			}
+			e0 += stepX[0];
+			e1 += stepX[1];
+			e2 += stepX[2];
+			e3 += stepX[3];
+			depth += depthStepX;
+		}
+#endif
+	}
+}
+
+bool OcclusionBuffer::isVisible(const AABB &box) const {
+	glm::vec2 screenMin(static_cast<float>(_width), static_cast<float>(_height));
+	glm::vec2 screenMax(0.0f);
+	float nearest = 0.0f;
+	for (int i = 0; i < 8; ++i) {
+		glm::vec3 corner(i & 1 ? box.max.x : box.min.x, i & 2 ? box.max.y : box.min.y, i & 4 ? box.max.z : box.min.z);
+		glm::vec3 screen;
+		if (!project(corner, screen)) {
+			// Boîte coupée par le plan proche : la caméra est dedans ou presque
+			return true;
+		}
+		screenMin.x = std::min(screenMin.x, screen.x);
+		screenMin.y = std::min(screenMin.y, screen.y);
+		screenMax.x = std::max(screenMax.x, screen.x);
+		screenMax.y = std::max(screenMax.y, screen.y);
+		nearest = std::max(nearest, screen.z);
+	}
+
+	// Tous les pixels touchés par le rectangle englobant, pas seulement ceux dont le centre est couvert
+	int minX = std::max(0, static_cast<int>(std::floor(screenMin.x)));
+	int maxX = std::min(_width - 1, static_cast<int>(std::floor(screenMax.x)));
+	int minY = std::max(0, static_cast<int>(std::floor(screenMin.y)));
+	int maxY = std::min(_height - 1, static_cast<int>(std::floor(screenMax.y)));
+	if (minX > maxX || minY > maxY) {
+		// Hors de l'écran : c'est au frustum d'en décider
+		return true;
+	}
+
+	nearest *= 1.0f + DEPTH_BIAS;
+	for (int y = minY; y <= maxY; ++y) {
+		const float *row = &_depth[y * _width];
+		// Tester quelques pixels de plus à gauche et à droite ne peut que rendre la boîte visible
+#ifdef OCCLUSION_BUFFER_SSE
+		const __m128 boxDepth = _mm_set1_ps(nearest);
+		for (int x = minX & ~3; x <= maxX; x += 4) {
+			if (_mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(row + x), boxDepth))) {
+				return true;
+			}
+		}
+#else
+		for (int x = minX; x <= maxX; ++x) {
+			if (row[x] <= nearest) {
+				return true;
+			}
+		}
+#endif
+	}
+	return false;
+}
+
+int OcclusionBuffer::getWidth() const {
+	return _width;
+}
+
+int OcclusionBuffer::getHeight() const {
+	return _height;
+}
+
+float OcclusionBuffer::getDepth(int x, int y) const {
+	return _depth[y * _width + x];
+}
+
+unsigned int OcclusionBuffer::getQuadCount() const {
+	return _quadCount;
+}
+
+} // namespace Render3D
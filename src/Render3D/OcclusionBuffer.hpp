@@ -0,0 +1,64 @@
+#ifndef RENDER3D_OCCLUSION_BUFFER_HPP
+#define RENDER3D_OCCLUSION_BUFFER_HPP
+
+#include <vector>
+#include <glm/glm.hpp>
+#include "AABB.hpp"
+
+namespace Render3D {
+
+/*
+	Tampon de profondeur basse résolution rempli sur le CPU avec les grandes faces opaques
+	des chunks les plus proches (Voxel::OccluderQuad), puis utilisé pour écarter les chunks
+	entièrement cachés avant de les ajouter à la file de rendu.
+
+	On stocke 1/w (w = profondeur dans l'espace de la vue) : cette valeur varie linéairement
+	sur l'écran, donc s'interpole exactement dans un quad. 0 = rien de dessiné, plus grand = plus proche.
+	Les occulteurs sont rastérisés de façon conservatrice : un pixel ne reçoit que les quads qui le
+	couvrent entièrement, avec leur 1/w le plus lointain sur le pixel. Un pixel à moitié couvert
+	(silhouette d'un mur ou du terrain) reste donc vide et ne cache jamais une boîte.
+*/
+class OcclusionBuffer {
+public:
+	static constexpr int DEFAULT_WIDTH = 256;
+	static constexpr int DEFAULT_HEIGHT = 128;
+
+	/// @param width Largeur en pixels, arrondie au multiple de 4 (4 pixels traités à la fois)
+	OcclusionBuffer(int width = DEFAULT_WIDTH, int height = DEFAULT_HEIGHT);
+
+	/// @brief Vider le tampon et fixer la caméra de l'image
+	void clear(const glm::mat4 &viewProjMatrix);
+
+	/// @brief Dessiner un quad plan et convexe (coins dans l'ordre)
+	/// @return false si le quad coupe le plan proche (ignoré : moins d'occulteurs, jamais de faux positif)
+	bool drawQuad(const glm::vec3 (&corners)[4]);
+	/// @brief Dessiner un rectangle aligné sur les axes (boîte plate sur un axe)
+	bool drawRectangle(const AABB &rectangle);
+
+	/// @brief La boîte est-elle visible à travers les occulteurs dessinés ?
+	/// Vrai si un pixel qu'elle couvre n'a pas d'occulteur strictement plus proche que son coin le plus proche
+	bool isVisible(const AABB &box) const;
+
+	int getWidth() const;
+	int getHeight() const;
+	/// @brief 1/w du pixel, le plus lointain de l'occulteur le plus proche qui le couvre (0 = aucun occulteur)
+	float getDepth(int x, int y) const;
+	/// @brief Quads dessinés depuis le dernier clear()
+	unsigned int getQuadCount() const;
+
+private:
+	/// @brief Coordonnées écran (pixels) et 1/w d'un point du monde
+	/// @return false si le point est derrière le plan proche
+	bool project(const glm::vec3 &point, glm::vec3 &screen) const;
+	/// @brief Rastériser un quad déjà projeté (coins en pixels et 1/w)
+	void drawConvexQuad(glm::vec3 (&quad)[4]);
+
+	int _width, _height;
+	std::vector<float> _depth;
+	glm::mat4 _viewProjMatrix;
+	unsigned int _quadCount;
+};
+
+} // namespace Render3D
+
+#endif // RENDER3D_OCCLUSION_BUFFER_HPP
@@ -0,0 +1,96 @@
+#ifndef RENDER3D_RENDER_QUEUE_HPP
+#define RENDER3D_RENDER_QUEUE_HPP
+
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include "../Core/Shader.hpp"
+#include "RenderStats.hpp"
+
+namespace Render3D {
+
+/// @brief Uniformes communs à tous les appels de dessin d'une image, envoyés une fois par changement de shader
+struct FrameUniforms {
+	glm::mat4 view;
+	glm::mat4 projection;
+	float fogStart;
+	float fogEnd;
+	glm::vec4 fogColor;
+};
+
+/// @brief Appel de dessin enregistré pendant le parcours de la scène
+struct DrawCommand {
+	const Shader *shader = nullptr;
+	GLenum textureTarget = GL_TEXTURE_2D;
+	GLuint texture = 0;
+	GLuint vao = 0;
+	const glm::mat4 *model = nullptr;	// nullptr : pas d'uniforme "model" (rendu instancié)
+	unsigned int count = 0;				// nombre d'indices
+	unsigned int offset = 0;			// premier indice
+	unsigned int instances = 0;			// 0 : glDrawElements, sinon glDrawElementsInstanced
+	bool transparent = false;
+};
+
+/*
+	File de rendu : les commandes sont triées par une clé de 64 bits puis soumises
+	en ne changeant l'état OpenGL que lorsqu'il diffère de la commande précédente.
+
+	Opaque       │ 0 │ shader:7 │ texture:16 │ vao:16 │ profondeur:24 │  (proche vers loin)
+	Transparent  │ 1 │ ~profondeur:24 │ shader:7 │ texture:16 │ vao:16 │  (loin vers proche)
+*/
+class RenderQueue {
+public:
+	/// @brief Vider la file et fixer la position de la caméra pour le calcul des profondeurs
+	void begin(const glm::vec3 &cameraPosition);
+
+	/// @brief Ajouter une commande, position sert à trier par profondeur
+	void push(const DrawCommand &command, const glm::vec3 &position);
+
+	/// @brief Tri par base (radix sort) des clés, 8 bits par passe
+	void sort();
+
+	/// @brief Exécuter les commandes triées
+	void submit(const FrameUniforms &frame, RenderStats &stats) const;
+
+	size_t size() const;
+
+	/// @brief Oublier les identifiants de tri et les uniformes résolus, à appeler quand des shaders,
+	/// textures ou VAO sont détruits ou recréés (OpenGL réutilise les noms libérés)
+	void releaseResources();
+
+private:
+	/// @brief Uniformes utilisés par la soumission, résolus une fois par shader
+	struct ShaderUniforms {
+		UniformHandle view, projection, model;
+		UniformHandle fogStart, fogEnd, fogColor;
+	};
+
+	const ShaderUniforms &getShaderUniforms(const Shader &shader) const;
+
+	struct SortItem {
+		uint64_t key;
+		uint32_t command;
+	};
+
+	uint64_t makeKey(const DrawCommand &command, float distance);
+
+	/// @brief Identifiant compact d'une ressource pour la clé, attribué à la première rencontre
+	static uint32_t getID(std::unordered_map<uint64_t, uint32_t> &ids, uint64_t resource, uint32_t maxID);
+
+	glm::vec3 _cameraPosition;
+	std::vector<DrawCommand> _commands;
+	std::vector<SortItem> _items;
+	std::vector<SortItem> _scratch;
+
+	std::unordered_map<uint64_t, uint32_t> _shaderIDs;
+	std::unordered_map<uint64_t, uint32_t> _textureIDs;
+	std::unordered_map<uint64_t, uint32_t> _vaoIDs;
+
+	mutable std::unordered_map<GLuint, ShaderUniforms> _shaderUniforms;	// par programme OpenGL
+};
+
+} // namespace Render3D
+
+#endif // RENDER3D_RENDER_QUEUE_HPP
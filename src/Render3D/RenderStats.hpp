@@ -0,0 +1,27 @@
+#ifndef RENDER3D_RENDER_STATS_HPP
+#define RENDER3D_RENDER_STATS_HPP
+
+namespace Render3D {
+
+/// @brief Compteurs du rendu d'une image, remis à zéro au début de Scene3D::render
+struct RenderStats {
+	unsigned int visible = 0;	// chunks et entités dans le frustum
+	unsigned int culled = 0;	// chunks et entités écartés avant d'entrer dans la file
+	unsigned int occluded = 0;	// chunks dans le frustum mais cachés dans OcclusionBuffer
+	unsigned int unreachable = 0;	// chunks dans le frustum mais hors du parcours par faces reliées
+	unsigned int drawCalls = 0;
+	unsigned int shaderBinds = 0;
+	unsigned int textureBinds = 0;
+	unsigned int vaoBinds = 0;
+	unsigned int stateChangesAvoided = 0;	// liaisons et uniformes d'image évités grâce au tri de RenderQueue
+	unsigned int uniformUploads = 0;
+	unsigned int uniformUploadsSkipped = 0;	// valeur identique à la dernière envoyée (voir Shader::setMat4(UniformHandle, ...))
+
+	void reset() {
+		*this = RenderStats();
+	}
+};
+
+} // namespace Render3D
+
+#endif // RENDER3D_RENDER_STATS_HPP
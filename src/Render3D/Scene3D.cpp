@@ -1,14 +1,26 @@
 #include "Scene3D.hpp"
 #include <algorithm> // pour std::remove
+#include <chrono>
 #include <glm/gtc/matrix_transform.hpp>
 #include "../Core/Logger.hpp"
 
 namespace Render3D {
 
-Scene3D::Scene3D(std::shared_ptr<Camera> camera) : _camera(camera), _enabled(true) {
+// Occulteurs dessinés par image, en partant des chunks les plus proches
+static const unsigned int MAX_OCCLUDER_QUADS = 1024;
+
+// Marge des boîtes de l'arbre des entités : un objet qui bouge de moins ne modifie pas l'arbre
+static const float ENTITY_TREE_MARGIN = 0.25f;
+// Feuilles réinsérées par image pour corriger la dégradation de l'arbre due aux déplacements
+static const int ENTITY_TREE_OPTIMIZE_COUNT = 4;
+
+Scene3D::Scene3D(std::shared_ptr<Camera> camera) : _camera(camera), _entityTree(ENTITY_TREE_MARGIN), _enabled(true) {
+	_meshJobs = std::make_unique<Voxel::MeshJobSystem>();
 }
 
 bool Scene3D::initialize() {
+	// Les shaders recréés peuvent reprendre les noms OpenGL des précédents
+	_renderQueue.releaseResources();
 	_shader3DTexture = std::make_shared<Shader>(PATH_SHADERS_3D + "shader_3d_texture.vert", PATH_SHADERS_3D + "shader_3d_texture.frag");
 	//_shader3DTexture = std::make_shared<Shader>(PATH_SHADERS_3D + "primitive_shader.vert", PATH_SHADERS_3D + "primitive_shader.frag");
 	const std::string &err1 = _shader3DTexture->getError();
@@ -23,12 +35,30 @@ bool Scene3D::initialize() {
 		LOG(Error) << err2;
 		return false;
 	}
+
+	_shader3DChunk = std::make_shared<Shader>(PATH_SHADERS_3D + "shader_3d_chunk.vert", PATH_SHADERS_3D + "shader_3d_chunk.frag");
+	const std::string &err3 = _shader3DChunk->getError();
+	if (!err3.empty()) {
+		LOG(Error) << err3;
+		return false;
+	}
+
+	_shader3DInstanced = std::make_shared<Shader>(PATH_SHADERS_3D + "shader_3d_instanced.vert", PATH_SHADERS_3D + "shader_3d_instanced.frag");
+	const std::string &err4 = _shader3DInstanced->getError();
+	if (!err4.empty()) {
+		LOG(Error) << err4;
+		return false;
+	}
+
+	LOG(Debug) << "Frustum culling path: " << FrustumCuller::getPathName(FrustumCuller::getBestPath());
 	return true;
 }
 
 void Scene3D::reset() {
 	clearEntities();
 	clearLights();
+	setWorld(nullptr);
+	_renderQueue.releaseResources();
 }
 
 void Scene3D::setEnable(bool enable) {
@@ -45,21 +75,315 @@ void Scene3D::setFog(float start, float end, const glm::vec4 &color) {
 	_fogColor = color;
 }
 
-void Scene3D::addEntity(std::shared_ptr<Entity> entity) {
+void Scene3D::setWorld(Voxel::WorldPtr world) {
+	_world = world;
+	_chunkMeshes.clear();
+	_chunkCullerDirty = true;
+	_chunkMeshStats = Voxel::MeshStats();
+
+	_blockTextures.free();
+
+	if (_world) {
+		// Les sommets des chunks référencent la couche = indice de la texture dans le registre
+		const auto &textures = _world->getRegistry().getTextures();
+		if (!textures.empty() && !_blockTextures.createFromTextures(textures)) {
+			LOG(Error) << "Failed to build the block texture array";
+		}
+
+		// Ensuite seuls les chunks signalés par le monde sont remaillés : tous ceux qui existent déjà le sont ici
+		_world->clearChunkChanges();
+		for (const auto &[pos, chunk] : _world->getChunks()) {
+			submitChunkMesh(pos, *chunk);
+		}
+	}
+}
+
+void Scene3D::setOcclusionCulling(bool enable) {
+	_occlusionCulling = enable;
+}
+
+bool Scene3D::isOcclusionCulling() const {
+	return _occlusionCulling;
+}
+
+void Scene3D::setCaveCulling(bool enable) {
+	_caveCulling = enable;
+}
+
+bool Scene3D::isCaveCulling() const {
+	return _caveCulling;
+}
+
+Voxel::WorldPtr Scene3D::getWorld() const {
+	return _world;
+}
+
+void Scene3D::updateChunkMeshes() {
+	if (!_world) {
+		return;
+	}
+
+	// Supprimer les meshes des chunks qui n'existent plus (un chunk supprimé puis recréé garde le sien)
+	for (const Voxel::ChunkPos &pos : _world->getRemovedChunks()) {
+		auto it = _chunkMeshes.find(pos);
+		if (it != _chunkMeshes.end() && !_world->getChunk(pos)) {
+			_chunkMeshStats -= it->second->getStats();
+			_chunkMeshes.erase(it);
+			_chunkCullerDirty = true;
+		}
+	}
+
+	// Les chunks sont copiés ici puis maillés sur les threads de travail
+	for (const Voxel::ChunkPos &pos : _world->getChangedChunks()) {
+		Voxel::Chunk *chunk = _world->getChunk(pos);
+		// Chunk supprimé depuis, ou position déjà traitée plus haut dans la liste
+		if (!chunk || !chunk->isDirty()) {
+			continue;
+		}
+		submitChunkMesh(pos, *chunk);
+	}
+	_world->clearChunkChanges();
+}
+
+void Scene3D::submitChunkMesh(const Voxel::ChunkPos &pos, Voxel::Chunk &chunk) {
+	auto &mesh = _chunkMeshes[pos];
+	if (!mesh) {
+		mesh = std::make_unique<ChunkMesh>(pos);
+		_chunkCullerDirty = true;
+	}
+	mesh->setPendingJob(_meshJobs->submit(*_world, pos));
+	chunk.setDirty(false);
+}
+
+void Scene3D::updateChunkCuller() {
+	if (!_chunkCullerDirty) {
+		return;
+	}
+	_chunkCuller.clear();
+	_culledChunkMeshes.clear();
+	_chunkCuller.reserve(_chunkMeshes.size());
+	_culledChunkMeshes.reserve(_chunkMeshes.size());
+	_chunkBoundsMin = {0, 0, 0};
+	_chunkBoundsMax = {-1, -1, -1};
+	for (const auto &[pos, mesh] : _chunkMeshes) {
+		_chunkCuller.add(mesh->getWorldAABB());
+		_culledChunkMeshes.push_back(mesh.get());
+
+		if (_culledChunkMeshes.size() == 1) {
+			_chunkBoundsMin = _chunkBoundsMax = pos;
+		}
+		_chunkBoundsMin = {std::min(_chunkBoundsMin.x, pos.x), std::min(_chunkBoundsMin.y, pos.y), std::min(_chunkBoundsMin.z, pos.z)};
+		_chunkBoundsMax = {std::max(_chunkBoundsMax.x, pos.x), std::max(_chunkBoundsMax.y, pos.y), std::max(_chunkBoundsMax.z, pos.z)};
+	}
+	_chunkCullerDirty = false;
+}
+
+void Scene3D::findReachableChunks(const Frustum &frustum) const {
+	_reachableChunks.clear();
+
+	// Les blocs sont centrés sur leurs coordonnées entières : le chunk 0 couvre [-0.5, CHUNK_SIZE - 0.5[
+	glm::vec3 cameraBlock = glm::floor(_camera->getPosition() + glm::vec3(0.5f));
+	Voxel::ChunkPos start = Voxel::World::toChunkPos(static_cast<int>(cameraBlock.x), static_cast<int>(cameraBlock.y), static_cast<int>(cameraBlock.z));
+
+	// Parcours limité aux chunks existants et à celui de la caméra (l'air au-delà ne cache rien)
+	Voxel::ChunkPos boundsMin = {std::min(_chunkBoundsMin.x, start.x), std::min(_chunkBoundsMin.y, start.y), std::min(_chunkBoundsMin.z, start.z)};
+	Voxel::ChunkPos boundsMax = {std::max(_chunkBoundsMax.x, start.x), std::max(_chunkBoundsMax.y, start.y), std::max(_chunkBoundsMax.z, start.z)};
+
+	struct Step {
+		Voxel::ChunkPos position;
+		int entryFace;				// face du chunk par laquelle on est entré, -1 pour celui de la caméra
+		unsigned int directions;	// faces de sortie déjà empruntées depuis la caméra (bits de BlockFace)
+	};
+	std::vector<Step> queue;
+	queue.push_back({start, -1, 0});
+	_reachableChunks.insert(start);
+
+	for (std::size_t head = 0; head < queue.size(); ++head) {
+		const Step step = queue[head];
+		auto it = _chunkMeshes.find(step.position);
+		// Chunk absent (air) ou pas encore maillé : toutes les faces se voient
+		Voxel::FaceConnections connections = it != _chunkMeshes.end() ? it->second->getFaceConnections() : Voxel::FaceConnections::all();
+
+		for (int face = 0; face < Voxel::FaceCount; ++face) {
+			// Faces opposées : Front/Back, Left/Right, Top/Bottom
+			const int opposite = face ^ 1;
+			if (step.directions & (1u << opposite)) {
+				continue;
+			}
+			if (step.entryFace >= 0 && !connections.canSee(step.entryFace, face)) {
+				continue;
+			}
+
+			const int *offset = Voxel::ChunkMesher::FACE_OFFSETS[face];
+			Voxel::ChunkPos next = {step.position.x + offset[0], step.position.y + offset[1], step.position.z + offset[2]};
+			if (next.x < boundsMin.x || next.y < boundsMin.y || next.z < boundsMin.z ||
+				next.x > boundsMax.x || next.y > boundsMax.y || next.z > boundsMax.z ||
+				_reachableChunks.count(next)) {
+				continue;
+			}
+
+			glm::vec3 origin = glm::vec3(next.x, next.y, next.z) * static_cast<float>(Voxel::CHUNK_SIZE) - glm::vec3(0.5f);
+			if (!frustum.AABBIsInside({origin, origin + glm::vec3(Voxel::CHUNK_SIZE)})) {
+				continue;
+			}
+
+			_reachableChunks.insert(next);
+			queue.push_back({next, opposite, step.directions | (1u << face)});
+		}
+	}
+}
+
+unsigned int Scene3D::uploadChunkMeshes(float timeBudget) {
+	auto start = std::chrono::steady_clock::now();
+	unsigned int uploaded = 0;
+
+	std::unique_ptr<Voxel::MeshJobResult> result;
+	while (_meshJobs->poll(result)) {
+		auto it = _chunkMeshes.find(result->position);
+		// Ignorer les meshes de chunks supprimés ou déjà remplacés par un travail plus récent
+		if (!_world || it == _chunkMeshes.end() || it->second->getPendingJob() != result->jobID) {
+			continue;
+		}
+		// Total tenu à jour mesh par mesh, sans refaire la somme de tous les chunks
+		_chunkMeshStats -= it->second->getStats();
+		it->second->upload(result->data);
+		_chunkMeshStats += it->second->getStats();
+		uploaded++;
+
+		if (std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() >= timeBudget) {
+			break;
+		}
+	}
+
+	if (uploaded > 0 && _meshJobs->getPendingCount() == 0) {
+		LOG(Debug) << "Chunk meshes up to date: " << _chunkMeshStats.emittedFaces << " faces emitted / "
+				   << _chunkMeshStats.theoreticalFaces << " theoretical, " << _chunkMeshStats.quads * 2 << " triangles, "
+				   << _chunkMeshStats.meshingTime << " ms";
+	}
+	return uploaded;
+}
+
+const Voxel::MeshStats &Scene3D::getChunkMeshStats() const {
+	return _chunkMeshStats;
+}
+
+const RenderStats &Scene3D::getRenderStats() const {
+	return _renderStats;
+}
+
+EntityHandle Scene3D::addEntity(std::shared_ptr<Entity> entity) {
 	// on véririfie que l'entité n'est pas déjà dans la scène
-	if (std::find(_entities.begin(), _entities.end(), entity)!= _entities.end()) {
+	EntityHandle handle = _entities.add(entity);
+	if (!handle.isValid()) {
 		LOG(Error) << "Entity already in scene";
-		return;
+		return handle;
 	}
-	_entities.push_back(entity);
+	if (handle.index >= _entitySlots.size()) {
+		_entitySlots.resize(handle.index + 1);
+	}
+	EntitySlot &slot = _entitySlots[handle.index];
+	slot.proxy = _entityTree.insert(entity->getWorldAABB(), entity.get());
+	slot.transformVersion = entity->getTransformVersion();
+	if (!entity->isStatic()) {
+		slot.dynamicIndex = _dynamicEntities.size();
+		_dynamicEntities.push_back(handle);
+	}
+
+	if (entity->isInstanced()) {
+		_instancedRenderer.add(std::static_pointer_cast<Object>(entity));
+	}
+	return handle;
 }
 
 void Scene3D::removeEntity(std::shared_ptr<Entity> entity) {
-	_entities.erase(std::remove(_entities.begin(), _entities.end(), entity), _entities.end());
+	if (entity) {
+		removeEntity(_entities.find(entity.get()));
+	}
+}
+
+void Scene3D::removeEntity(EntityHandle handle) {
+	std::shared_ptr<Entity> entity = _entities.get(handle);
+	if (!entity) {
+		return;
+	}
+	EntitySlot &slot = _entitySlots[handle.index];
+	_entityTree.remove(slot.proxy);
+	if (slot.dynamicIndex != EntitySlot::STATIC) {
+		// Retrait en O(1) : la dernière entité dynamique prend la place de celle retirée
+		_dynamicEntities[slot.dynamicIndex] = _dynamicEntities.back();
+		_entitySlots[_dynamicEntities[slot.dynamicIndex].index].dynamicIndex = slot.dynamicIndex;
+		_dynamicEntities.pop_back();
+	}
+	slot = EntitySlot();
+	_entities.remove(handle);
+
+	if (entity->isInstanced()) {
+		_instancedRenderer.remove(std::static_pointer_cast<Object>(entity));
+	}
 }
 
 void Scene3D::clearEntities() {
 	_entities.clear();
+	_entityTree.clear();
+	_entitySlots.clear();
+	_dynamicEntities.clear();
+	_instancedRenderer.clear();
+}
+
+std::shared_ptr<Entity> Scene3D::getEntity(EntityHandle handle) const {
+	return _entities.get(handle);
+}
+
+EntityHandle Scene3D::findEntity(const Entity *entity) const {
+	return _entities.find(entity);
+}
+
+void Scene3D::refreshEntity(EntityHandle handle) {
+	std::shared_ptr<Entity> entity = _entities.get(handle);
+	if (!entity) {
+		return;
+	}
+	EntitySlot &slot = _entitySlots[handle.index];
+	uint32_t version = entity->getTransformVersion();
+	if (version != slot.transformVersion) {
+		slot.transformVersion = version;
+		_entityTree.move(slot.proxy, entity->getWorldAABB());
+		if (entity->isInstanced()) {
+			_instancedRenderer.refresh(*std::static_pointer_cast<Object>(entity));
+		}
+	}
+}
+
+size_t Scene3D::getEntityCount() const {
+	return _entities.size();
+}
+
+std::shared_ptr<Entity> Scene3D::pickEntity(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance) const {
+	const glm::vec3 inverseDirection = 1.0f / direction;
+	const Entity *closest = nullptr;
+	// Les boîtes de l'arbre ont une marge : on reteste la boîte exacte et on raccourcit le rayon à chaque touche
+	_entityTree.raycast(origin, direction, maxDistance, [&](void *userData, float) {
+		const Entity *entity = static_cast<const Entity *>(userData);
+		float distance;
+		if (entity->getWorldAABB().intersectsRay(origin, inverseDirection, maxDistance, distance)) {
+			closest = entity;
+			maxDistance = distance;
+		}
+		return maxDistance;
+	});
+	if (!closest) {
+		return nullptr;
+	}
+	return _entities.get(_entities.find(closest));
+}
+
+void Scene3D::queryEntities(const AABB &box, std::vector<std::shared_ptr<Entity>> &result) const {
+	_entityTree.query(box, [&](void *userData) {
+		const Entity *entity = static_cast<const Entity *>(userData);
+		if (entity->getWorldAABB().overlaps(box)) {
+			result.push_back(_entities.get(_entities.find(entity)));
+		}
+	});
 }
 
 void Scene3D::addLight(std::shared_ptr<Light> light) {
@@ -94,10 +418,23 @@ void Scene3D::handleEvent(const SDL_Event &event) {
 
 void Scene3D::update(float dt) {
 	if (_enabled) {
+		updateChunkMeshes();
+		updateChunkCuller();
+
 		//LOG(Debug) << "Update entities...";
-		for (auto &entity : _entities) {
+		// Les entités statiques ne sont pas parcourues : leur matrice et leur boîte restent en cache
+		for (EntityHandle handle : _dynamicEntities) {
+			const std::shared_ptr<Entity> &entity = _entities.get(handle);
 			entity->update(dt);
+			EntitySlot &slot = _entitySlots[handle.index];
+			uint32_t version = entity->getTransformVersion();
+			if (version != slot.transformVersion) {
+				slot.transformVersion = version;
+				_entityTree.move(slot.proxy, entity->getWorldAABB());
+			}
 		}
+		_entityTree.optimize(ENTITY_TREE_OPTIMIZE_COUNT);
+		_instancedRenderer.update();
 		//LOG(Debug) << "Entities are updated";
 	}
 }
@@ -114,6 +451,11 @@ void Scene3D::render(float aspectRatio) const {
 	*/
 
 
+	_renderStats.reset();
+	for (const auto &shader : {_shader3DTexture, _shader3DChunk, _shader3DInstanced}) {
+		shader->resetUniformStats();
+	}
+
     if (_enabled) {
         // Matrices de vue et de projection
         glm::mat4 viewMatrix       = _camera->getViewMatrix();
@@ -124,27 +466,88 @@ void Scene3D::render(float aspectRatio) const {
         Frustum frustum;
 		frustum.CalculatePlanes(viewProjMatrix);
 
-		// Rendu des entités visibles
-        for (const auto& entity : _entities) {
-            auto corners = entity->getBoundingBoxCorners();
-			// adapter les coordonnées pour des coins du cube dans l'espace de la scène
-			for (auto &corner : corners) {
-				corner = entity->modelMatrix() * glm::vec4(corner, 1.0f);
+		// Parcours de la scène : chaque élément ajoute ses appels de dessin à la file
+		_renderQueue.begin(_camera->getPosition());
+
+		if (_blockTextures.isLoaded()) {
+			// Toutes les boîtes de chunks testées d'un coup (SSE/AVX), puis lecture du masque
+			_chunkCuller.cull(frustum, _chunkVisibility);
+			if (_caveCulling) {
+				findReachableChunks(frustum);
+			}
+			_frustumChunks.clear();
+			for (std::size_t i = 0; i < _culledChunkMeshes.size(); ++i) {
+				const ChunkMesh *mesh = _culledChunkMeshes[i];
+				if (mesh->isEmpty()) {
+					continue;
+				}
+				if (!FrustumCuller::isVisible(_chunkVisibility, i)) {
+					_renderStats.culled++;
+					continue;
+				}
+				if (_caveCulling && !_reachableChunks.count(mesh->getPosition())) {
+					_renderStats.unreachable++;
+					continue;
+				}
+				glm::vec3 offset = mesh->getWorldAABB().getCenter() - _camera->getPosition();
+				_frustumChunks.emplace_back(glm::dot(offset, offset), mesh);
+			}
+
+			if (_occlusionCulling) {
+				// Les chunks proches cachent le plus : leurs faces opaques sont dessinées en premier
+				std::sort(_frustumChunks.begin(), _frustumChunks.end(),
+						  [](const auto &a, const auto &b) { return a.first < b.first; });
+				_occlusionBuffer.clear(viewProjMatrix);
+				unsigned int quads = 0;
+				for (const auto &[distance, mesh] : _frustumChunks) {
+					for (const auto &occluder : mesh->getOccluders()) {
+						_occlusionBuffer.drawRectangle(occluder);
+					}
+					quads += mesh->getOccluders().size();
+					if (quads >= MAX_OCCLUDER_QUADS) {
+						break;
+					}
+				}
+			}
+
+			for (const auto &[distance, mesh] : _frustumChunks) {
+				if (_occlusionCulling && !_occlusionBuffer.isVisible(mesh->getWorldAABB())) {
+					_renderStats.occluded++;
+					continue;
+				}
+				_renderStats.visible++;
+				mesh->enqueue(_renderQueue, *_shader3DChunk, _blockTextures);
 			}
+		}
 
-			_shader3DTexture->use();
-			_shader3DTexture->setMat4("view", viewMatrix);
-			_shader3DTexture->setMat4("projection", projectionMatrix);
-			_shader3DTexture->setMat4("model", entity->modelMatrix());
-
-			_shader3DTexture->setFloat("fogStart", _fogStart);
-			_shader3DTexture->setFloat("fogEnd", _fogEnd);
-			_shader3DTexture->setVec4("fogColor", _fogColor);
-            
-			//if (frustum.LeastOnePointIsInside(corners)) {
-                entity->render(*_shader3DTexture);
-            //}
-        }
+		// Seules les branches de l'arbre dans le frustum sont parcourues, puis la boîte exacte de chaque entité est testée
+		_visibleInstances.clear();
+		unsigned int visibleEntities = 0;
+		_entityTree.query(frustum, [&](void *userData) {
+			const Entity *entity = static_cast<const Entity *>(userData);
+			if (!frustum.AABBIsInside(entity->getWorldAABB())) {
+				return;
+			}
+			visibleEntities++;
+			if (entity->isInstanced() && static_cast<const Object *>(entity)->isTextured()) {
+				_visibleInstances.push_back(static_cast<const Object *>(entity));
+			} else {
+				entity->enqueue(_renderQueue, *_shader3DTexture);
+			}
+		});
+		_instancedRenderer.enqueue(_renderQueue, *_shader3DInstanced, _visibleInstances);
+		_renderStats.visible += visibleEntities;
+		_renderStats.culled += _entities.size() - visibleEntities;
+
+		// Tri par état (shader, texture, VAO, profondeur) puis soumission : view, projection
+		// et brouillard ne sont envoyés qu'une fois par shader
+		_renderQueue.sort();
+		_renderQueue.submit({viewMatrix, projectionMatrix, _fogStart, _fogEnd, _fogColor}, _renderStats);
+
+		for (const auto &shader : {_shader3DTexture, _shader3DChunk, _shader3DInstanced}) {
+			_renderStats.uniformUploads += shader->getUniformStats().uploads;
+			_renderStats.uniformUploadsSkipped += shader->getUniformStats().skipped;
+		}
 
         // Utilisation du shader de lumière 3D
         /*_shader3DLight->use();
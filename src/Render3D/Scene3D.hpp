@@ -16,11 +16,23 @@
 
 #include <vector>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <SDL2/SDL.h>
 #include <glm/glm.hpp>
 #include "../Core/Shader.hpp"
+#include "../Core/TextureArray.hpp"
 #include "Entities/Entity.hpp"
+#include "ChunkMesh.hpp"
+#include "InstancedRenderer.hpp"
+#include "RenderQueue.hpp"
+#include "../Voxel/World.hpp"
+#include "../Voxel/MeshJobSystem.hpp"
 #include "Frustum.hpp"
+#include "FrustumCuller.hpp"
+#include "AABBTree.hpp"
+#include "EntityRegistry.hpp"
+#include "OcclusionBuffer.hpp"
 #include "Camera.hpp"
 #include "Lights/Light.hpp"
 #include "Lights/DirectionalLight.hpp"
@@ -51,9 +63,37 @@ public:
 
 	void setFog(float start, float end, const glm::vec4 &color);
 
-	void addEntity(std::shared_ptr<Entity> entity);
+	/// @brief Activer/désactiver le test des chunks contre le tampon de profondeur CPU
+	void setOcclusionCulling(bool enable);
+	bool isOcclusionCulling() const;
+
+	/// @brief Activer/désactiver le parcours des chunks par faces reliées (grottes, pièces fermées)
+	void setCaveCulling(bool enable);
+	bool isCaveCulling() const;
+
+	/// @brief Définir le monde voxel rendu par chunks
+	void setWorld(Voxel::WorldPtr world);
+	Voxel::WorldPtr getWorld() const;
+
+	/// @brief Ajouter une entité (O(1))
+	/// @return Handle stable de l'entité, invalide si elle est déjà dans la scène
+	EntityHandle addEntity(std::shared_ptr<Entity> entity);
 	void removeEntity(std::shared_ptr<Entity> entity);
+	void removeEntity(EntityHandle handle);
 	void clearEntities();
+	/// @return nullptr si l'entité a été retirée de la scène
+	std::shared_ptr<Entity> getEntity(EntityHandle handle) const;
+	EntityHandle findEntity(const Entity *entity) const;
+	/// @brief Prendre en compte le déplacement d'une entité statique (Entity::setStatic)
+	/// Les entités dynamiques sont suivies automatiquement à chaque update()
+	void refreshEntity(EntityHandle handle);
+	size_t getEntityCount() const;
+
+	/// @brief Entité la plus proche touchée par un rayon (boîte englobante dans l'espace du monde)
+	/// @return nullptr si aucune entité n'est touchée à moins de maxDistance
+	std::shared_ptr<Entity> pickEntity(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance) const;
+	/// @brief Ajouter à result les entités dont la boîte chevauche box
+	void queryEntities(const AABB &box, std::vector<std::shared_ptr<Entity>> &result) const;
 
 	void addLight(std::shared_ptr<Light> light);
 	void removeLight(std::shared_ptr<Light> light);
@@ -61,17 +101,77 @@ public:
 
 	bool entitiesSetupSuccessfully() const;
 
+	/// @brief Envoyer au GPU les meshes de chunks construits en arrière-plan
+	/// @param timeBudget Temps maximal passé dans les envois (en millisecondes), au moins un mesh est envoyé
+	/// @return Nombre de meshes envoyés
+	unsigned int uploadChunkMeshes(float timeBudget);
+
+	/// @brief Faces générées / faces théoriques de tous les chunks
+	const Voxel::MeshStats &getChunkMeshStats() const;
+
+	/// @brief Appels de dessin et liaisons de textures de la dernière image
+	const RenderStats &getRenderStats() const;
+
 	void handleEvent(const SDL_Event& event);
 	void update(float dt);
 	void render(float aspectRatio) const;
 
 private:
+	/// @brief Lancer la reconstruction des meshes des chunks modifiés et supprimer ceux des chunks disparus
+	/// (listes du monde : World::getChangedChunks, World::getRemovedChunks)
+	void updateChunkMeshes();
+	/// @brief Créer le mesh du chunk si besoin et lancer son maillage en arrière-plan
+	void submitChunkMesh(const Voxel::ChunkPos &pos, Voxel::Chunk &chunk);
+	/// @brief Recopier les boîtes des chunks dans le culler si des chunks ont été ajoutés ou supprimés
+	void updateChunkCuller();
+
+	/// @brief Parcours en largeur depuis le chunk de la caméra : on passe d'un chunk à son voisin
+	/// si la face d'entrée voit la face de sortie (Voxel::FaceConnections), sans revenir vers la caméra
+	/// et seulement dans le frustum. Remplit _reachableChunks.
+	void findReachableChunks(const Frustum &frustum) const;
+
 	std::shared_ptr<Camera> _camera;
 	std::shared_ptr<Shader> _shader3DTexture;
 	std::shared_ptr<Shader> _shader3DLight;
-	std::vector<std::shared_ptr<Entity>> _entities;
+	std::shared_ptr<Shader> _shader3DChunk;
+	std::shared_ptr<Shader> _shader3DInstanced;
+	/// @brief Données de la scène pour chaque emplacement d'EntityRegistry (indexées par EntityHandle::index)
+	struct EntitySlot {
+		static constexpr size_t STATIC = static_cast<size_t>(-1);
+
+		int proxy = AABBTree::NULL_NODE;	// feuille de _entityTree
+		uint32_t transformVersion = 0;		// version de la boîte envoyée à l'arbre
+		size_t dynamicIndex = STATIC;		// rang dans _dynamicEntities
+	};
+
+	EntityRegistry _entities;
+	AABBTree _entityTree;						// boîtes des entités, userData = Entity*
+	std::vector<EntitySlot> _entitySlots;
+	std::vector<EntityHandle> _dynamicEntities;	// seules entités mises à jour à chaque image
+	InstancedRenderer _instancedRenderer;	// objets de même géométrie dessinés en un appel
+	mutable std::vector<const Object *> _visibleInstances;
 	std::vector<std::shared_ptr<Light>> _lights;
 
+	Voxel::WorldPtr _world;
+	std::unordered_map<Voxel::ChunkPos, ChunkMeshPtr, Voxel::ChunkPosHash> _chunkMeshes;
+	FrustumCuller _chunkCuller;					// boîtes des chunks en SoA, même ordre que _culledChunkMeshes
+	std::vector<const ChunkMesh *> _culledChunkMeshes;
+	mutable std::vector<uint64_t> _chunkVisibility;
+	bool _chunkCullerDirty = true;				// reconstruire après ajout/suppression de chunks
+	mutable std::vector<std::pair<float, const ChunkMesh *>> _frustumChunks;	// distance² à la caméra, chunk
+	mutable OcclusionBuffer _occlusionBuffer;
+	bool _occlusionCulling = true;
+	Voxel::ChunkPos _chunkBoundsMin = {0, 0, 0};	// chunks existants, ceux qui manquent dedans sont de l'air
+	Voxel::ChunkPos _chunkBoundsMax = {-1, -1, -1};
+	mutable std::unordered_set<Voxel::ChunkPos, Voxel::ChunkPosHash> _reachableChunks;
+	bool _caveCulling = true;
+	std::unique_ptr<Voxel::MeshJobSystem> _meshJobs;
+	Voxel::MeshStats _chunkMeshStats;
+	TextureArray _blockTextures;	// une couche par texture du BlockRegistry
+
+	mutable RenderQueue _renderQueue;
+	mutable RenderStats _renderStats;
+
 	float _fogStart = 5.0f;
 	float _fogEnd = 30.0f;
 	glm::vec4 _fogColor = glm::vec4(0.7, 0.8, 0.9, 1.0); // bleu-gris
@@ -0,0 +1,62 @@
+#include "Block.hpp"
+#include "../Core/Logger.hpp"
+
+namespace Voxel {
+
+BlockRegistry::BlockRegistry() {
+	// L'air est toujours le bloc 0
+	_blocks.push_back({"air", {0, 0, 0, 0, 0, 0}, true});
+}
+
+BlockID BlockRegistry::registerBlock(const std::string &name, const std::array<std::shared_ptr<Texture>, FaceCount> &facesTextures, bool transparent) {
+	BlockType block;
+	block.name = name;
+	block.transparent = transparent;
+	for (int i = 0; i < FaceCount; ++i) {
+		block.facesTextures[i] = registerTexture(facesTextures[i]);
+	}
+	_blocks.push_back(block);
+	return static_cast<BlockID>(_blocks.size() - 1);
+}
+
+const BlockType &BlockRegistry::getBlock(BlockID id) const {
+	if (id >= _blocks.size()) {
+		LOG(Error) << "Unknown block id: " << id;
+		return _blocks[BLOCK_AIR];
+	}
+	return _blocks[id];
+}
+
+BlockID BlockRegistry::getBlockID(const std::string &name) const {
+	for (size_t i = 0; i < _blocks.size(); ++i) {
+		if (_blocks[i].name == name) {
+			return static_cast<BlockID>(i);
+		}
+	}
+	LOG(Error) << "Block not found: " << name;
+	return BLOCK_AIR;
+}
+
+size_t BlockRegistry::getBlockCount() const {
+	return _blocks.size();
+}
+
+bool BlockRegistry::isOpaque(BlockID id) const {
+	return id != BLOCK_AIR && id < _blocks.size() && !_blocks[id].transparent;
+}
+
+const std::vector<std::shared_ptr<Texture>> &BlockRegistry::getTextures() const {
+	return _textures;
+}
+
+unsigned int BlockRegistry::registerTexture(const std::shared_ptr<Texture> &texture) {
+	for (size_t i = 0; i < _textures.size(); ++i) {
+		if (_textures[i] == texture) {
+			return static_cast<unsigned int>(i);
+		}
+	}
+	_textures.push_back(texture);
+	return static_cast<unsigned int>(_textures.size() - 1);
+}
+
+} // namespace Voxel
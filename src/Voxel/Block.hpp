@@ -0,0 +1,73 @@
+/**
+ * @file Block.hpp
+ * @brief Types de blocs du monde voxel
+ */
+
+#ifndef VOXEL_BLOCK_HPP
+#define VOXEL_BLOCK_HPP
+
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <string>
+#include <memory>
+
+class Texture;
+
+namespace Voxel {
+
+/// @brief Identifiant d'un type de bloc (0 = air)
+using BlockID = uint16_t;
+
+constexpr BlockID BLOCK_AIR = 0;
+
+/// @brief Faces d'un bloc, dans le même ordre que CUBE_VERTICES
+enum BlockFace {
+	FaceFront = 0,	// +z
+	FaceBack,		// -z
+	FaceLeft,		// -x
+	FaceRight,		// +x
+	FaceTop,		// +y
+	FaceBottom,		// -y
+	FaceCount
+};
+
+struct BlockType {
+	std::string name;
+	std::array<unsigned int, FaceCount> facesTextures; // indices dans BlockRegistry::getTextures()
+	bool transparent;
+};
+
+/// @brief Table des types de blocs et des textures qu'ils utilisent
+class BlockRegistry {
+public:
+	BlockRegistry();
+
+	/// @brief Enregistrer un nouveau type de bloc
+	/// @param name Nom du bloc
+	/// @param facesTextures Textures des faces (front, back, left, right, top, bottom)
+	/// @param transparent True si on voit à travers le bloc (verre, feuillage...)
+	/// @return Identifiant du bloc
+	BlockID registerBlock(const std::string &name, const std::array<std::shared_ptr<Texture>, FaceCount> &facesTextures, bool transparent = false);
+
+	const BlockType &getBlock(BlockID id) const;
+	BlockID getBlockID(const std::string &name) const;
+	size_t getBlockCount() const;
+
+	/// @brief Un bloc opaque cache entièrement les faces de ses voisins
+	bool isOpaque(BlockID id) const;
+
+	const std::vector<std::shared_ptr<Texture>> &getTextures() const;
+
+private:
+	unsigned int registerTexture(const std::shared_ptr<Texture> &texture);
+
+	std::vector<BlockType> _blocks;
+	std::vector<std::shared_ptr<Texture>> _textures;
+};
+
+using BlockRegistryPtr = std::shared_ptr<BlockRegistry>;
+
+} // namespace Voxel
+
+#endif // VOXEL_BLOCK_HPP
@@ -0,0 +1,81 @@
+#include "Chunk.hpp"
+
+namespace Voxel {
+
+Chunk::Chunk(const ChunkPos &position)
+	: _position(position), _blocks(CHUNK_VOLUME, BLOCK_AIR), _blockCount(0), _meshingMode(MeshingMode::Greedy), _dirty(true) {
+}
+
+const ChunkPos &Chunk::getPosition() const {
+	return _position;
+}
+
+BlockID Chunk::getBlock(int x, int y, int z) const {
+	return _blocks.get(index(x, y, z));
+}
+
+void Chunk::setBlock(int x, int y, int z, BlockID id) {
+	int i = index(x, y, z);
+	BlockID block = _blocks.get(i);
+	if (block == id) {
+		return;
+	}
+	if (block == BLOCK_AIR) {
+		_blockCount++;
+	} else if (id == BLOCK_AIR) {
+		_blockCount--;
+	}
+	_blocks.set(i, id);
+	_dirty = true;
+}
+
+void Chunk::fill(BlockID id) {
+	_blocks.fill(id);
+	_blockCount = (id == BLOCK_AIR) ? 0 : CHUNK_VOLUME;
+	_dirty = true;
+}
+
+bool Chunk::isUniform() const {
+	return _blocks.isSingleValue();
+}
+
+void Chunk::compact() {
+	_blocks.compact();
+}
+
+size_t Chunk::getMemoryUsage() const {
+	return _blocks.getMemoryUsage();
+}
+
+const PalettedContainer &Chunk::getBlocks() const {
+	return _blocks;
+}
+
+unsigned int Chunk::getBlockCount() const {
+	return _blockCount;
+}
+
+bool Chunk::isEmpty() const {
+	return _blockCount == 0;
+}
+
+MeshingMode Chunk::getMeshingMode() const {
+	return _meshingMode;
+}
+
+void Chunk::setMeshingMode(MeshingMode mode) {
+	if (_meshingMode != mode) {
+		_meshingMode = mode;
+		_dirty = true;
+	}
+}
+
+bool Chunk::isDirty() const {
+	return _dirty;
+}
+
+void Chunk::setDirty(bool dirty) {
+	_dirty = dirty;
+}
+
+} // namespace Voxel
@@ -0,0 +1,100 @@
+/**
+ * @file Chunk.hpp
+ * @brief Tronçon de monde de CHUNK_SIZE³ blocs
+ */
+
+#ifndef VOXEL_CHUNK_HPP
+#define VOXEL_CHUNK_HPP
+
+#include <cstddef>
+#include <functional>
+#include "Block.hpp"
+#include "PalettedContainer.hpp"
+
+namespace Voxel {
+
+constexpr int CHUNK_SHIFT  = 4;
+constexpr int CHUNK_SIZE   = 1 << CHUNK_SHIFT; // 16
+constexpr int CHUNK_MASK   = CHUNK_SIZE - 1;
+constexpr int CHUNK_AREA   = CHUNK_SIZE * CHUNK_SIZE;
+constexpr int CHUNK_VOLUME = CHUNK_AREA * CHUNK_SIZE;
+
+/// @brief Position d'un chunk en coordonnées de chunk (bloc >> CHUNK_SHIFT)
+struct ChunkPos {
+	int x, y, z;
+
+	bool operator==(const ChunkPos &other) const {
+		return x == other.x && y == other.y && z == other.z;
+	}
+	bool operator!=(const ChunkPos &other) const {
+		return !(*this == other);
+	}
+};
+
+struct ChunkPosHash {
+	size_t operator()(const ChunkPos &pos) const {
+		// Mélange des trois coordonnées avec des grands nombres premiers
+		return static_cast<size_t>(pos.x) * 73856093u
+			 ^ static_cast<size_t>(pos.y) * 19349663u
+			 ^ static_cast<size_t>(pos.z) * 83492791u;
+	}
+};
+
+/// @brief Algorithme utilisé pour construire le mesh d'un chunk
+enum class MeshingMode {
+	Naive,	// un quad par face visible
+	Greedy	// faces coplanaires identiques fusionnées en rectangles
+};
+
+class Chunk {
+public:
+	Chunk(const ChunkPos &position);
+
+	const ChunkPos &getPosition() const;
+
+	/// @brief Lire un bloc en coordonnées locales [0, CHUNK_SIZE[
+	BlockID getBlock(int x, int y, int z) const;
+
+	/// @brief Modifier un bloc en coordonnées locales [0, CHUNK_SIZE[
+	void setBlock(int x, int y, int z, BlockID id);
+
+	/// @brief Remplir tout le chunk avec un même bloc
+	void fill(BlockID id);
+
+	/// @brief Le chunk ne contient qu'un seul type de bloc (tout air, tout pierre...)
+	bool isUniform() const;
+
+	/// @brief Réduire la palette aux blocs réellement présents
+	void compact();
+
+	/// @brief Mémoire occupée par les blocs (en octets)
+	size_t getMemoryUsage() const;
+
+	const PalettedContainer &getBlocks() const;
+
+	/// @brief Nombre de blocs non vides
+	unsigned int getBlockCount() const;
+	bool isEmpty() const;
+
+	MeshingMode getMeshingMode() const;
+	void setMeshingMode(MeshingMode mode);
+
+	/// @brief Le mesh du chunk doit être reconstruit
+	bool isDirty() const;
+	void setDirty(bool dirty);
+
+	static inline int index(int x, int y, int z) {
+		return x + (z << CHUNK_SHIFT) + (y << (2 * CHUNK_SHIFT));
+	}
+
+private:
+	ChunkPos _position;
+	PalettedContainer _blocks;
+	unsigned int _blockCount;
+	MeshingMode _meshingMode;
+	bool _dirty;
+};
+
+} // namespace Voxel
+
+#endif // VOXEL_CHUNK_HPP
@@ -0,0 +1,307 @@
+#include "ChunkMesher.hpp"
+#include "World.hpp"
+#include <array>
+#include <algorithm>
+#include <chrono>
+
+namespace Voxel {
+
+const int ChunkMesher::FACE_OFFSETS[FaceCount][3] = {
+	{ 0,  0,  1}, // Front
+	{ 0,  0, -1}, // Back
+	{-1,  0,  0}, // Left
+	{ 1,  0,  0}, // Right
+	{ 0,  1,  0}, // Top
+	{ 0, -1,  0}, // Bottom
+};
+
+const int ChunkMesher::FACE_AXES[FaceCount][3] = {
+	{2, 0, 1}, // Front  : normale z, u = x, v = y
+	{2, 0, 1}, // Back
+	{0, 2, 1}, // Left   : normale x, u = z, v = y
+	{0, 2, 1}, // Right
+	{1, 0, 2}, // Top    : normale y, u = x, v = z
+	{1, 0, 2}, // Bottom
+};
+
+// Sommets d'une face : position (x,y,z) et coordonnées de texture (u,v), même ordre que CUBE_VERTICES
+static const float FACE_VERTICES[FaceCount][4][5] = {
+	// Front face
+	{{-0.5f, -0.5f,  0.5f, 0.0f, 0.0f}, { 0.5f, -0.5f,  0.5f, 1.0f, 0.0f}, { 0.5f,  0.5f,  0.5f, 1.0f, 1.0f}, {-0.5f,  0.5f,  0.5f, 0.0f, 1.0f}},
+	// Back face
+	{{-0.5f, -0.5f, -0.5f, 0.0f, 0.0f}, { 0.5f, -0.5f, -0.5f, 1.0f, 0.0f}, { 0.5f,  0.5f, -0.5f, 1.0f, 1.0f}, {-0.5f,  0.5f, -0.5f, 0.0f, 1.0f}},
+	// Left face
+	{{-0.5f, -0.5f, -0.5f, 0.0f, 0.0f}, {-0.5f, -0.5f,  0.5f, 1.0f, 0.0f}, {-0.5f,  0.5f,  0.5f, 1.0f, 1.0f}, {-0.5f,  0.5f, -0.5f, 0.0f, 1.0f}},
+	// Right face
+	{{ 0.5f, -0.5f, -0.5f, 0.0f, 0.0f}, { 0.5f, -0.5f,  0.5f, 1.0f, 0.0f}, { 0.5f,  0.5f,  0.5f, 1.0f, 1.0f}, { 0.5f,  0.5f, -0.5f, 0.0f, 1.0f}},
+	// Top face
+	{{-0.5f,  0.5f,  0.5f, 0.0f, 0.0f}, { 0.5f,  0.5f,  0.5f, 1.0f, 0.0f}, { 0.5f,  0.5f, -0.5f, 1.0f, 1.0f}, {-0.5f,  0.5f, -0.5f, 0.0f, 1.0f}},
+	// Bottom face
+	{{-0.5f, -0.5f,  0.5f, 0.0f, 0.0f}, { 0.5f, -0.5f,  0.5f, 1.0f, 0.0f}, { 0.5f, -0.5f, -0.5f, 1.0f, 1.0f}, {-0.5f, -0.5f, -0.5f, 0.0f, 1.0f}},
+};
+
+BlockID ChunkNeighbourhood::getBlock(int x, int y, int z) const {
+	if (x >= 0 && x < CHUNK_SIZE && y >= 0 && y < CHUNK_SIZE && z >= 0 && z < CHUNK_SIZE) {
+		return center->getBlock(x, y, z);
+	}
+
+	// Un seul axe peut sortir du chunk pour les voisins directs d'un bloc
+	const Chunk *neighbour;
+	if (x < 0)					neighbour = neighbours[FaceLeft];
+	else if (x >= CHUNK_SIZE)	neighbour = neighbours[FaceRight];
+	else if (y < 0)				neighbour = neighbours[FaceBottom];
+	else if (y >= CHUNK_SIZE)	neighbour = neighbours[FaceTop];
+	else if (z < 0)				neighbour = neighbours[FaceBack];
+	else						neighbour = neighbours[FaceFront];
+
+	if (!neighbour) {
+		return BLOCK_AIR;
+	}
+	return neighbour->getBlock(x & CHUNK_MASK, y & CHUNK_MASK, z & CHUNK_MASK);
+}
+
+void ChunkMeshData::clear() {
+	vertices.clear();
+	indices.clear();
+	transparentOffset = 0;
+	transparentVertices.clear();
+	occluders.clear();
+	faceConnections = FaceConnections::all();
+	stats = MeshStats();
+}
+
+ChunkNeighbourhood ChunkMesher::getNeighbourhood(const World &world, const ChunkPos &pos) {
+	ChunkNeighbourhood neighbourhood;
+	neighbourhood.center = world.getChunk(pos);
+	for (int face = 0; face < FaceCount; ++face) {
+		ChunkPos neighbourPos = {pos.x + FACE_OFFSETS[face][0], pos.y + FACE_OFFSETS[face][1], pos.z + FACE_OFFSETS[face][2]};
+		neighbourhood.neighbours[face] = world.getChunk(neighbourPos);
+	}
+	return neighbourhood;
+}
+
+static inline bool isFaceVisible(const ChunkNeighbourhood &neighbourhood, const BlockRegistry &registry, BlockID id, const int cell[3], int face) {
+	// Face cachée par un voisin opaque ou par un bloc transparent identique (verre contre verre)
+	BlockID neighbour = neighbourhood.getBlock(cell[0] + ChunkMesher::FACE_OFFSETS[face][0],
+											   cell[1] + ChunkMesher::FACE_OFFSETS[face][1],
+											   cell[2] + ChunkMesher::FACE_OFFSETS[face][2]);
+	return neighbour != id && !registry.isOpaque(neighbour);
+}
+
+/// @brief Ajouter un quad couvrant width x height blocs à partir de cell, les UV sont répétées sur chaque bloc
+static void emitQuad(std::vector<ChunkVertex> &vertices, int face, const int cell[3], int width, int height, unsigned int layer) {
+	const int *axes = ChunkMesher::FACE_AXES[face];
+	int extent[3] = {1, 1, 1};
+	extent[axes[1]] = width;
+	extent[axes[2]] = height;
+
+	for (int v = 0; v < 4; ++v) {
+		const float *src = FACE_VERTICES[face][v];
+		// Coins entiers : le shader retire 0.5 pour centrer le bloc sur sa coordonnée
+		unsigned int corner[3];
+		for (int a = 0; a < 3; ++a) {
+			corner[a] = (src[a] < 0.0f) ? cell[a] : cell[a] + extent[a];
+		}
+		vertices.push_back(ChunkVertex::pack(corner[0], corner[1], corner[2], face,
+											 static_cast<unsigned int>(src[3]) * width,
+											 static_cast<unsigned int>(src[4]) * height,
+											 layer));
+	}
+}
+
+/// @brief Recouvrir un masque de tranche par des rectangles maximaux de même clé non nulle :
+/// extension en largeur (axe u) puis en hauteur (axe v) tant que la ligne entière correspond
+/// @param emit Appelé avec (a, b, largeur, hauteur, clé) pour chaque rectangle, le masque est remis à 0
+template <typename Emit>
+static void coverMask(std::array<unsigned int, CHUNK_AREA> &mask, Emit &&emit) {
+	for (int b = 0; b < CHUNK_SIZE; ++b) {
+		for (int a = 0; a < CHUNK_SIZE;) {
+			unsigned int key = mask[a + b * CHUNK_SIZE];
+			if (key == 0) {
+				++a;
+				continue;
+			}
+
+			int width = 1;
+			while (a + width < CHUNK_SIZE && mask[a + width + b * CHUNK_SIZE] == key) {
+				++width;
+			}
+
+			int height = 1;
+			for (; b + height < CHUNK_SIZE; ++height) {
+				bool rowMatches = true;
+				for (int k = 0; k < width; ++k) {
+					if (mask[a + k + (b + height) * CHUNK_SIZE] != key) {
+						rowMatches = false;
+						break;
+					}
+				}
+				if (!rowMatches) {
+					break;
+				}
+			}
+
+			for (int h = 0; h < height; ++h) {
+				std::fill_n(&mask[a + (b + h) * CHUNK_SIZE], width, 0u);
+			}
+
+			emit(a, b, width, height, key);
+			a += width;
+		}
+	}
+}
+
+void ChunkMesher::build(const ChunkNeighbourhood &neighbourhood, const BlockRegistry &registry, ChunkMeshData &mesh) {
+	auto start = std::chrono::steady_clock::now();
+	mesh.clear();
+
+	const Chunk &chunk = *neighbourhood.center;
+	if (chunk.isEmpty()) {
+		return;
+	}
+	mesh.stats.theoreticalFaces = chunk.getBlockCount() * FaceCount;
+
+	if (chunk.getMeshingMode() == MeshingMode::Greedy) {
+		buildGreedy(neighbourhood, registry, mesh.vertices, mesh.transparentVertices, mesh.stats);
+	} else {
+		buildNaive(neighbourhood, registry, mesh.vertices, mesh.transparentVertices, mesh.stats);
+	}
+	buildOccluders(neighbourhood, registry, mesh.occluders);
+	mesh.faceConnections = FaceConnections::compute(chunk, registry);
+
+	// Faces transparentes à la suite des opaques : le chunk les dessine dans un second appel,
+	// trié de loin vers près avec les autres objets transparents
+	mesh.transparentOffset = static_cast<unsigned int>(mesh.vertices.size() / 4 * 6);
+	mesh.vertices.insert(mesh.vertices.end(), mesh.transparentVertices.begin(), mesh.transparentVertices.end());
+	mesh.transparentVertices.clear();
+
+	// Les faces de toutes les textures partagent le même tampon : la couche est lue dans le sommet
+	mesh.indices.reserve(mesh.stats.quads * 6);
+	for (unsigned int q = 0; q < mesh.stats.quads; ++q) {
+		unsigned int i = q * 4;
+		mesh.indices.insert(mesh.indices.end(), {i, i + 1, i + 2, i + 2, i + 3, i});
+	}
+
+	mesh.stats.meshingTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void ChunkMesher::buildNaive(const ChunkNeighbourhood &neighbourhood, const BlockRegistry &registry, std::vector<ChunkVertex> &vertices, std::vector<ChunkVertex> &transparentVertices, MeshStats &stats) {
+	const Chunk &chunk = *neighbourhood.center;
+	int cell[3];
+	for (cell[1] = 0; cell[1] < CHUNK_SIZE; ++cell[1]) {
+		for (cell[2] = 0; cell[2] < CHUNK_SIZE; ++cell[2]) {
+			for (cell[0] = 0; cell[0] < CHUNK_SIZE; ++cell[0]) {
+				BlockID id = chunk.getBlock(cell[0], cell[1], cell[2]);
+				if (id == BLOCK_AIR) {
+					continue;
+				}
+				const BlockType &block = registry.getBlock(id);
+				std::vector<ChunkVertex> &target = block.transparent ? transparentVertices : vertices;
+				for (int face = 0; face < FaceCount; ++face) {
+					if (!isFaceVisible(neighbourhood, registry, id, cell, face)) {
+						continue;
+					}
+					emitQuad(target, face, cell, 1, 1, block.facesTextures[face]);
+					stats.emittedFaces++;
+					stats.quads++;
+				}
+			}
+		}
+	}
+}
+
+void ChunkMesher::buildGreedy(const ChunkNeighbourhood &neighbourhood, const BlockRegistry &registry, std::vector<ChunkVertex> &vertices, std::vector<ChunkVertex> &transparentVertices, MeshStats &stats) {
+	/*
+		Pour chaque direction et chaque tranche perpendiculaire, on construit un masque
+		CHUNK_SIZE x CHUNK_SIZE des faces visibles (clé = texture + 1, 0 = pas de face,
+		bit de poids fort pour les blocs transparents), puis on le recouvre avec des
+		rectangles maximaux de même clé (coverMask).
+	*/
+	const unsigned int TRANSPARENT_KEY = 1u << 31;
+	const Chunk &chunk = *neighbourhood.center;
+	std::array<unsigned int, CHUNK_AREA> mask;
+
+	for (int face = 0; face < FaceCount; ++face) {
+		const int n = FACE_AXES[face][0];
+		const int u = FACE_AXES[face][1];
+		const int v = FACE_AXES[face][2];
+
+		for (int slice = 0; slice < CHUNK_SIZE; ++slice) {
+			int cell[3];
+			cell[n] = slice;
+
+			bool empty = true;
+			for (cell[v] = 0; cell[v] < CHUNK_SIZE; ++cell[v]) {
+				for (cell[u] = 0; cell[u] < CHUNK_SIZE; ++cell[u]) {
+					unsigned int &key = mask[cell[u] + cell[v] * CHUNK_SIZE];
+					key = 0;
+					BlockID id = chunk.getBlock(cell[0], cell[1], cell[2]);
+					if (id == BLOCK_AIR || !isFaceVisible(neighbourhood, registry, id, cell, face)) {
+						continue;
+					}
+					const BlockType &block = registry.getBlock(id);
+					key = (block.facesTextures[face] + 1) | (block.transparent ? TRANSPARENT_KEY : 0u);
+					stats.emittedFaces++;
+					empty = false;
+				}
+			}
+			if (empty) {
+				continue;
+			}
+
+			coverMask(mask, [&](int a, int b, int width, int height, unsigned int key) {
+				cell[u] = a;
+				cell[v] = b;
+				emitQuad(key & TRANSPARENT_KEY ? transparentVertices : vertices, face, cell, width, height, (key & ~TRANSPARENT_KEY) - 1);
+				stats.quads++;
+			});
+		}
+	}
+}
+
+void ChunkMesher::buildOccluders(const ChunkNeighbourhood &neighbourhood, const BlockRegistry &registry, std::vector<OccluderQuad> &occluders) {
+	// Même parcours que buildGreedy, mais une seule clé pour tous les blocs opaques
+	const Chunk &chunk = *neighbourhood.center;
+	std::array<unsigned int, CHUNK_AREA> mask;
+
+	for (int face = 0; face < FaceCount; ++face) {
+		const int n = FACE_AXES[face][0];
+		const int u = FACE_AXES[face][1];
+		const int v = FACE_AXES[face][2];
+		// Les faces positives (Front, Right, Top) sont sur le bord supérieur du bloc
+		const int offset = FACE_OFFSETS[face][n] > 0 ? 1 : 0;
+
+		for (int slice = 0; slice < CHUNK_SIZE; ++slice) {
+			int cell[3];
+			cell[n] = slice;
+
+			bool empty = true;
+			for (cell[v] = 0; cell[v] < CHUNK_SIZE; ++cell[v]) {
+				for (cell[u] = 0; cell[u] < CHUNK_SIZE; ++cell[u]) {
+					unsigned int &key = mask[cell[u] + cell[v] * CHUNK_SIZE];
+					BlockID id = chunk.getBlock(cell[0], cell[1], cell[2]);
+					key = registry.isOpaque(id) && isFaceVisible(neighbourhood, registry, id, cell, face);
+					empty &= key == 0;
+				}
+			}
+			if (empty) {
+				continue;
+			}
+
+			coverMask(mask, [&](int a, int b, int width, int height, unsigned int) {
+				if (width * height < MIN_OCCLUDER_AREA) {
+					return;
+				}
+				OccluderQuad quad;
+				quad.min[n] = quad.max[n] = static_cast<uint8_t>(slice + offset);
+				quad.min[u] = static_cast<uint8_t>(a);
+				quad.max[u] = static_cast<uint8_t>(a + width);
+				quad.min[v] = static_cast<uint8_t>(b);
+				quad.max[v] = static_cast<uint8_t>(b + height);
+				occluders.push_back(quad);
+			});
+		}
+	}
+}
+
+} // namespace Voxel
@@ -0,0 +1,142 @@
+/**
+ * @file ChunkMesher.hpp
+ * @brief Génération de la géométrie d'un chunk (côté CPU)
+ */
+
+#ifndef VOXEL_CHUNK_MESHER_HPP
+#define VOXEL_CHUNK_MESHER_HPP
+
+#include <vector>
+#include <cstdint>
+#include "Chunk.hpp"
+#include "FaceConnections.hpp"
+
+namespace Voxel {
+
+class World;
+
+/// @brief Chunk et ses 6 voisins directs, pour tester les faces en bordure
+struct ChunkNeighbourhood {
+	const Chunk *center;
+	const Chunk *neighbours[FaceCount]; // indexés par BlockFace, nullptr = air
+
+	/// @brief Lire un bloc en coordonnées locales au centre, dans [-1, CHUNK_SIZE]
+	BlockID getBlock(int x, int y, int z) const;
+};
+
+/// @brief Compteurs de faces pour vérifier l'efficacité du mesher
+struct MeshStats {
+	unsigned int emittedFaces = 0;		// faces de blocs visibles
+	unsigned int theoreticalFaces = 0;	// 6 faces par bloc non vide
+	unsigned int quads = 0;				// quads générés (= emittedFaces sans fusion, 2 triangles chacun)
+	float meshingTime = 0.0f;			// en millisecondes
+
+	MeshStats &operator+=(const MeshStats &other) {
+		emittedFaces += other.emittedFaces;
+		theoreticalFaces += other.theoreticalFaces;
+		quads += other.quads;
+		meshingTime += other.meshingTime;
+		return *this;
+	}
+
+	MeshStats &operator-=(const MeshStats &other) {
+		emittedFaces -= other.emittedFaces;
+		theoreticalFaces -= other.theoreticalFaces;
+		quads -= other.quads;
+		meshingTime -= other.meshingTime;
+		return *this;
+	}
+};
+
+/*
+	Sommet compact d'un chunk : 8 octets au lieu des 36 de Object::setupMesh
+
+	          ┌──────┬──────┬──────┬────────┬──────┬──────┬─────┐
+	position  │  x:5 │  y:5 │  z:5 │ face:3 │  u:5 │  v:5 │  -  │
+	          └──────┴──────┴──────┴────────┴──────┴──────┴─────┘
+	          0      5      10     15       18     23     28    32
+	          ┌───────────┬─────────┬──────┬─────────────────────┐
+	attributes│ layer:12  │ light:4 │ ao:2 │          -          │
+	          └───────────┴─────────┴──────┴─────────────────────┘
+	          0           12        16     18                    32
+
+	x, y, z : coin du bloc dans le chunk [0, CHUNK_SIZE] (le centre du bloc est en +0.5)
+	face    : indice de BlockFace (sert de normale)
+	u, v    : coordonnées de texture, jusqu'à CHUNK_SIZE pour les quads fusionnés
+	layer   : indice de texture dans BlockRegistry::getTextures()
+	light   : niveau de lumière [0, 15], ao : occlusion ambiante [0, 3] (3 = aucune)
+*/
+struct ChunkVertex {
+	uint32_t position;
+	uint32_t attributes;
+
+	static constexpr unsigned int MAX_LIGHT = 15;
+	static constexpr unsigned int MAX_AO = 3;
+
+	static inline ChunkVertex pack(unsigned int x, unsigned int y, unsigned int z, unsigned int face, unsigned int u, unsigned int v,
+								   unsigned int layer, unsigned int light = MAX_LIGHT, unsigned int ao = MAX_AO) {
+		return {
+			x | (y << 5) | (z << 10) | (face << 15) | (u << 18) | (v << 23),
+			layer | (light << 12) | (ao << 16)
+		};
+	}
+};
+
+static_assert(sizeof(ChunkVertex) == 8, "ChunkVertex must stay 8 bytes");
+
+/// @brief Rectangle de faces opaques fusionnées, dessiné dans le tampon de profondeur CPU
+/// (Render3D::OcclusionBuffer). Coins en coordonnées de blocs du chunk comme les sommets :
+/// min et max sont égaux sur l'axe de la normale
+struct OccluderQuad {
+	uint8_t min[3];
+	uint8_t max[3];
+};
+
+/// @brief Géométrie d'un chunk prête à être envoyée au GPU, dessinée en un seul appel
+/// (la couche de texture de chaque face est dans ses sommets)
+struct ChunkMeshData {
+	std::vector<ChunkVertex> vertices;	// UV > 1 : texture répétée ; faces opaques puis faces transparentes
+	std::vector<unsigned int> indices;
+	unsigned int transparentOffset = 0;	// premier indice des faces de blocs transparents (= indices.size() sans elles)
+	std::vector<ChunkVertex> transparentVertices;	// tampon de construction, vide après build()
+	std::vector<OccluderQuad> occluders;	// grandes faces opaques, indépendamment des textures
+	FaceConnections faceConnections = FaceConnections::all();	// faces reliées par l'air, pour le culling des grottes
+	MeshStats stats;
+
+	void clear();
+};
+
+class ChunkMesher {
+public:
+	/// @brief Récupérer un chunk et ses voisins dans le monde
+	static ChunkNeighbourhood getNeighbourhood(const World &world, const ChunkPos &pos);
+
+	/// @brief Générer uniquement les faces visibles (voisin vide ou transparent)
+	/// selon le mode de meshing du chunk (Chunk::getMeshingMode)
+	static void build(const ChunkNeighbourhood &neighbourhood, const BlockRegistry &registry, ChunkMeshData &mesh);
+
+	/// @brief Décalage vers le voisin de chaque face
+	static const int FACE_OFFSETS[FaceCount][3];
+
+	/// @brief Axe de la normale puis axes u et v de la texture pour chaque face (0 = x, 1 = y, 2 = z)
+	static const int FACE_AXES[FaceCount][3];
+
+	/// @brief Surface minimale (en faces de blocs) d'un occulteur : les petits rectangles cachent peu
+	/// et coûtent autant à rasteriser
+	static constexpr int MIN_OCCLUDER_AREA = 4;
+
+private:
+	/// @brief Un quad par face visible
+	/// Les faces des blocs transparents vont dans transparentVertices, pour être dessinées après les opaques
+	static void buildNaive(const ChunkNeighbourhood &neighbourhood, const BlockRegistry &registry, std::vector<ChunkVertex> &vertices, std::vector<ChunkVertex> &transparentVertices, MeshStats &stats);
+
+	/// @brief Fusion des faces coplanaires de même texture et de même transparence en rectangles maximaux
+	static void buildGreedy(const ChunkNeighbourhood &neighbourhood, const BlockRegistry &registry, std::vector<ChunkVertex> &vertices, std::vector<ChunkVertex> &transparentVertices, MeshStats &stats);
+
+	/// @brief Fusion des faces visibles des blocs opaques, toutes textures confondues, en rectangles d'occultation
+	static void buildOccluders(const ChunkNeighbourhood &neighbourhood, const BlockRegistry &registry, std::vector<OccluderQuad> &occluders);
+};
+
+} // namespace Voxel
+
+#endif // VOXEL_CHUNK_MESHER_HPP
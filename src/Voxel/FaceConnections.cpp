@@ -0,0 +1,84 @@
+#include "FaceConnections.hpp"
+#include <bitset>
+#include <vector>
+
+namespace Voxel {
+
+/// @brief Faces du chunk touchées par le bloc (x, y, z), en masque de bits indexé par BlockFace
+static inline unsigned int touchedFaces(int x, int y, int z) {
+	unsigned int faces = 0;
+	if (x == 0)					faces |= 1u << FaceLeft;
+	if (x == CHUNK_SIZE - 1)	faces |= 1u << FaceRight;
+	if (y == 0)					faces |= 1u << FaceBottom;
+	if (y == CHUNK_SIZE - 1)	faces |= 1u << FaceTop;
+	if (z == 0)					faces |= 1u << FaceBack;
+	if (z == CHUNK_SIZE - 1)	faces |= 1u << FaceFront;
+	return faces;
+}
+
+FaceConnections FaceConnections::compute(const Chunk &chunk, const BlockRegistry &registry) {
+	if (chunk.isEmpty()) {
+		return all();
+	}
+	if (chunk.isUniform() && registry.isOpaque(chunk.getBlock(0, 0, 0))) {
+		return FaceConnections();
+	}
+
+	// Les blocs opaques sont marqués d'avance comme visités, il ne reste que les zones traversables
+	std::bitset<CHUNK_VOLUME> visited;
+	for (int i = 0; i < CHUNK_VOLUME; ++i) {
+		if (registry.isOpaque(chunk.getBlocks().get(i))) {
+			visited.set(i);
+		}
+	}
+
+	FaceConnections connections;
+	std::vector<int> stack;
+	stack.reserve(CHUNK_VOLUME);
+
+	for (int start = 0; start < CHUNK_VOLUME; ++start) {
+		if (visited[start]) {
+			continue;
+		}
+
+		unsigned int faces = 0;
+		visited.set(start);
+		stack.push_back(start);
+		while (!stack.empty()) {
+			int i = stack.back();
+			stack.pop_back();
+
+			// Inverse de Chunk::index : x + z * CHUNK_SIZE + y * CHUNK_AREA
+			int x = i & CHUNK_MASK;
+			int z = (i >> CHUNK_SHIFT) & CHUNK_MASK;
+			int y = i >> (2 * CHUNK_SHIFT);
+			faces |= touchedFaces(x, y, z);
+
+			const int neighbours[FaceCount] = {
+				z < CHUNK_SIZE - 1 ? i + CHUNK_SIZE : -1,	// Front
+				z > 0 ? i - CHUNK_SIZE : -1,				// Back
+				x > 0 ? i - 1 : -1,							// Left
+				x < CHUNK_SIZE - 1 ? i + 1 : -1,			// Right
+				y < CHUNK_SIZE - 1 ? i + CHUNK_AREA : -1,	// Top
+				y > 0 ? i - CHUNK_AREA : -1,				// Bottom
+			};
+			for (int neighbour : neighbours) {
+				if (neighbour >= 0 && !visited[neighbour]) {
+					visited.set(neighbour);
+					stack.push_back(neighbour);
+				}
+			}
+		}
+
+		for (int a = 0; a < FaceCount; ++a) {
+			for (int b = a + 1; b < FaceCount; ++b) {
+				if ((faces >> a & 1) && (faces >> b & 1)) {
+					connections.connect(a, b);
+				}
+			}
+		}
+	}
+	return connections;
+}
+
+} // namespace Voxel
@@ -0,0 +1,69 @@
+/**
+ * @file FaceConnections.hpp
+ * @brief Faces d'un chunk qui se voient à travers l'air (culling des grottes)
+ */
+
+#ifndef VOXEL_FACE_CONNECTIONS_HPP
+#define VOXEL_FACE_CONNECTIONS_HPP
+
+#include <cstdint>
+#include "Chunk.hpp"
+
+namespace Voxel {
+
+/*
+	Pour chacune des 15 paires de faces du chunk, un bit indique s'il existe un chemin
+	de blocs non opaques (air, verre...) entre ces deux faces. Le rendu parcourt ensuite
+	les chunks depuis celui de la caméra en ne traversant un chunk que par des faces reliées :
+	les grottes et pièces fermées ne sont plus dessinées depuis l'extérieur.
+*/
+class FaceConnections {
+public:
+	/// @brief Aucune face reliée (chunk plein)
+	FaceConnections() : _bits(0) {}
+
+	/// @brief Toutes les faces reliées (chunk vide ou inconnu)
+	static FaceConnections all() {
+		FaceConnections connections;
+		connections._bits = (1u << PAIR_COUNT) - 1;
+		return connections;
+	}
+
+	/// @brief Remplissage par diffusion de chaque zone de blocs non opaques du chunk :
+	/// toutes les faces touchées par une même zone se voient
+	static FaceConnections compute(const Chunk &chunk, const BlockRegistry &registry);
+
+	void connect(int faceA, int faceB) {
+		if (faceA != faceB) {
+			_bits |= 1u << pairIndex(faceA, faceB);
+		}
+	}
+
+	/// @brief Peut-on voir faceB en entrant par faceA (une face se voit toujours elle-même)
+	bool canSee(int faceA, int faceB) const {
+		return faceA == faceB || ((_bits >> pairIndex(faceA, faceB)) & 1);
+	}
+
+	uint16_t getBits() const {
+		return _bits;
+	}
+
+private:
+	static constexpr int PAIR_COUNT = FaceCount * (FaceCount - 1) / 2;
+
+	/// @brief Indice [0, 15[ de la paire non ordonnée (faceA, faceB), faceA != faceB
+	static int pairIndex(int faceA, int faceB) {
+		if (faceA > faceB) {
+			int face = faceA;
+			faceA = faceB;
+			faceB = face;
+		}
+		return faceA * (2 * FaceCount - faceA - 1) / 2 + faceB - faceA - 1;
+	}
+
+	uint16_t _bits;
+};
+
+} // namespace Voxel
+
+#endif // VOXEL_FACE_CONNECTIONS_HPP
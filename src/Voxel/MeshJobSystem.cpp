@@ -0,0 +1,66 @@
+#include "MeshJobSystem.hpp"
+#include "World.hpp"
+
+namespace Voxel {
+
+std::unique_ptr<ChunkSnapshot> ChunkSnapshot::capture(const World &world, const ChunkPos &pos) {
+	auto snapshot = std::make_unique<ChunkSnapshot>();
+	snapshot->position = pos;
+
+	// Copier les chunks : avec les palettes, une copie ne coûte que quelques centaines d'octets
+	ChunkNeighbourhood live = ChunkMesher::getNeighbourhood(world, pos);
+	if (live.center) {
+		snapshot->center = std::make_unique<Chunk>(*live.center);
+	} else {
+		snapshot->center = std::make_unique<Chunk>(pos);
+	}
+	for (int face = 0; face < FaceCount; ++face) {
+		if (live.neighbours[face]) {
+			snapshot->neighbours[face] = std::make_unique<Chunk>(*live.neighbours[face]);
+		}
+	}
+	return snapshot;
+}
+
+ChunkNeighbourhood ChunkSnapshot::getNeighbourhood() const {
+	ChunkNeighbourhood neighbourhood;
+	neighbourhood.center = center.get();
+	for (int face = 0; face < FaceCount; ++face) {
+		neighbourhood.neighbours[face] = neighbours[face].get();
+	}
+	return neighbourhood;
+}
+
+MeshJobSystem::MeshJobSystem(unsigned int threadCount)
+	: _nextJobID(1), _pending(0), _pool(threadCount) {
+}
+
+uint64_t MeshJobSystem::submit(const World &world, const ChunkPos &pos) {
+	uint64_t jobID = _nextJobID++;
+	std::shared_ptr<ChunkSnapshot> snapshot = ChunkSnapshot::capture(world, pos);
+	BlockRegistryPtr registry = world.getRegistryPtr();
+
+	_pending++;
+	_pool.submit([this, snapshot, registry, jobID]() {
+		auto result = std::make_unique<MeshJobResult>();
+		result->position = snapshot->position;
+		result->jobID = jobID;
+		ChunkMesher::build(snapshot->getNeighbourhood(), *registry, result->data);
+		_completed.push(std::move(result));
+	});
+	return jobID;
+}
+
+bool MeshJobSystem::poll(std::unique_ptr<MeshJobResult> &result) {
+	if (!_completed.pop(result)) {
+		return false;
+	}
+	_pending--;
+	return true;
+}
+
+size_t MeshJobSystem::getPendingCount() const {
+	return _pending;
+}
+
+} // namespace Voxel
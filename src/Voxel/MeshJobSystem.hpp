@@ -0,0 +1,61 @@
+/**
+ * @file MeshJobSystem.hpp
+ * @brief Construction des meshes de chunks sur des threads de travail
+ */
+
+#ifndef VOXEL_MESH_JOB_SYSTEM_HPP
+#define VOXEL_MESH_JOB_SYSTEM_HPP
+
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include "ChunkMesher.hpp"
+#include "../Core/ThreadPool.hpp"
+#include "../Core/MPSCQueue.hpp"
+
+namespace Voxel {
+
+class World;
+
+/// @brief Copie figée d'un chunk et de ses voisins, lisible depuis un autre thread
+struct ChunkSnapshot {
+	ChunkPos position;
+	std::unique_ptr<Chunk> center;
+	std::unique_ptr<Chunk> neighbours[FaceCount];
+
+	static std::unique_ptr<ChunkSnapshot> capture(const World &world, const ChunkPos &pos);
+
+	ChunkNeighbourhood getNeighbourhood() const;
+};
+
+/// @brief Mesh construit par un thread de travail, en attente d'envoi au GPU
+struct MeshJobResult {
+	ChunkPos position;
+	uint64_t jobID;
+	ChunkMeshData data;
+};
+
+class MeshJobSystem {
+public:
+	MeshJobSystem(unsigned int threadCount = 0);
+
+	/// @brief Capturer le chunk (sur le thread appelant) et lancer la construction de son mesh
+	/// @return Identifiant du travail, croissant, pour ignorer les résultats périmés
+	uint64_t submit(const World &world, const ChunkPos &pos);
+
+	/// @brief Récupérer un mesh terminé (thread principal uniquement)
+	bool poll(std::unique_ptr<MeshJobResult> &result);
+
+	/// @brief Nombre de travaux soumis dont le résultat n'a pas encore été récupéré
+	size_t getPendingCount() const;
+
+private:
+	uint64_t _nextJobID;
+	std::atomic<size_t> _pending;
+	MPSCQueue<std::unique_ptr<MeshJobResult>> _completed;
+	ThreadPool _pool; // détruit en premier : les threads sont arrêtés avant la file
+};
+
+} // namespace Voxel
+
+#endif // VOXEL_MESH_JOB_SYSTEM_HPP
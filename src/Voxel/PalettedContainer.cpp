@@ -0,0 +1,149 @@
+#include "PalettedContainer.hpp"
+#include <algorithm>
+
+namespace Voxel {
+
+PalettedContainer::PalettedContainer(size_t size, BlockID value)
+	: _size(size), _bits(0), _bitsShift(0), _mask(0), _palette(1, value) {
+}
+
+BlockID PalettedContainer::get(size_t index) const {
+	if (_bits == 0) {
+		return _palette[0];
+	}
+	if (_bits == DIRECT_BITS) {
+		return static_cast<BlockID>(readEntry(index));
+	}
+	return _palette[readEntry(index)];
+}
+
+void PalettedContainer::set(size_t index, BlockID id) {
+	if (_bits == DIRECT_BITS) {
+		writeEntry(index, id);
+		return;
+	}
+	if (_bits == 0 && _palette[0] == id) {
+		return;
+	}
+
+	auto it = std::find(_palette.begin(), _palette.end(), id);
+	size_t paletteIndex = it - _palette.begin();
+	if (it == _palette.end()) {
+		_palette.push_back(id);
+		unsigned int bits = bitsForPaletteSize(_palette.size());
+		if (bits != _bits) {
+			resize(bits);
+			if (_bits == DIRECT_BITS) {
+				writeEntry(index, id);
+				return;
+			}
+		}
+	}
+	writeEntry(index, static_cast<uint32_t>(paletteIndex));
+}
+
+void PalettedContainer::fill(BlockID id) {
+	_bits = 0;
+	_bitsShift = 0;
+	_mask = 0;
+	_palette.assign(1, id);
+	_data.clear();
+	_data.shrink_to_fit();
+}
+
+void PalettedContainer::compact() {
+	if (_bits == 0) {
+		return;
+	}
+
+	// Valeurs réellement présentes
+	std::vector<BlockID> used;
+	for (size_t i = 0; i < _size; ++i) {
+		BlockID id = get(i);
+		if (std::find(used.begin(), used.end(), id) == used.end()) {
+			used.push_back(id);
+			if (used.size() > (1u << 8)) {
+				return; // reste en mode direct
+			}
+		}
+	}
+
+	if (used.size() == 1) {
+		fill(used[0]);
+		return;
+	}
+
+	std::vector<BlockID> values(_size);
+	for (size_t i = 0; i < _size; ++i) {
+		values[i] = get(i);
+	}
+
+	_palette = used;
+	_bits = bitsForPaletteSize(_palette.size());
+	_bitsShift = __builtin_ctz(_bits);
+	_mask = (1u << _bits) - 1;
+	_data.assign(((_size << _bitsShift) + 63) / 64, 0);
+	_data.shrink_to_fit();
+	for (size_t i = 0; i < _size; ++i) {
+		size_t paletteIndex = std::find(_palette.begin(), _palette.end(), values[i]) - _palette.begin();
+		writeEntry(i, static_cast<uint32_t>(paletteIndex));
+	}
+}
+
+size_t PalettedContainer::size() const {
+	return _size;
+}
+
+unsigned int PalettedContainer::getBitsPerEntry() const {
+	return _bits;
+}
+
+size_t PalettedContainer::getPaletteSize() const {
+	return _palette.size();
+}
+
+bool PalettedContainer::isSingleValue() const {
+	return _bits == 0;
+}
+
+size_t PalettedContainer::getMemoryUsage() const {
+	return _data.capacity() * sizeof(uint64_t) + _palette.capacity() * sizeof(BlockID);
+}
+
+unsigned int PalettedContainer::bitsForPaletteSize(size_t paletteSize) {
+	if (paletteSize <= 1)   return 0;
+	if (paletteSize <= 2)   return 1;
+	if (paletteSize <= 4)   return 2;
+	if (paletteSize <= 16)  return 4;
+	if (paletteSize <= 256) return 8;
+	return DIRECT_BITS;
+}
+
+void PalettedContainer::resize(unsigned int bits) {
+	// Décoder les anciennes valeurs avant de changer de format
+	std::vector<BlockID> values(_size);
+	for (size_t i = 0; i < _size; ++i) {
+		values[i] = get(i);
+	}
+
+	_bits = bits;
+	_bitsShift = __builtin_ctz(bits);
+	_mask = (1u << bits) - 1;
+	_data.assign(((_size << _bitsShift) + 63) / 64, 0);
+
+	if (_bits == DIRECT_BITS) {
+		_palette.clear();
+		_palette.shrink_to_fit();
+		for (size_t i = 0; i < _size; ++i) {
+			writeEntry(i, values[i]);
+		}
+		return;
+	}
+
+	for (size_t i = 0; i < _size; ++i) {
+		size_t paletteIndex = std::find(_palette.begin(), _palette.end(), values[i]) - _palette.begin();
+		writeEntry(i, static_cast<uint32_t>(paletteIndex));
+	}
+}
+
+} // namespace Voxel
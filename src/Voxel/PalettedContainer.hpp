@@ -0,0 +1,83 @@
+/**
+ * @file PalettedContainer.hpp
+ * @brief Stockage compressé des blocs d'un chunk par palette locale
+ */
+
+#ifndef VOXEL_PALETTED_CONTAINER_HPP
+#define VOXEL_PALETTED_CONTAINER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "Block.hpp"
+
+namespace Voxel {
+
+/*
+	Chaque entrée est un indice dans une palette locale de BlockID, codé sur le
+	plus petit nombre de bits suffisant pour la taille de la palette :
+
+		palette  1       -> 0 bit   (valeur unique, aucune donnée)
+		palette  2       -> 1 bit
+		palette  3..4    -> 2 bits
+		palette  5..16   -> 4 bits
+		palette 17..256  -> 8 bits
+		au-delà          -> 16 bits (BlockID stocké directement, sans palette)
+
+	Les tailles sont des puissances de 2, une entrée ne chevauche donc jamais
+	deux mots de 64 bits.
+*/
+class PalettedContainer {
+public:
+	PalettedContainer(size_t size, BlockID value = BLOCK_AIR);
+
+	BlockID get(size_t index) const;
+	void set(size_t index, BlockID id);
+
+	/// @brief Remplir avec une seule valeur (retour au mode valeur unique)
+	void fill(BlockID id);
+
+	/// @brief Reconstruire la palette sans les entrées inutilisées et réduire les bits si possible
+	void compact();
+
+	size_t size() const;
+	unsigned int getBitsPerEntry() const;
+	size_t getPaletteSize() const;
+
+	/// @brief Toutes les entrées ont la même valeur
+	bool isSingleValue() const;
+
+	/// @brief Mémoire occupée par les données et la palette (en octets)
+	size_t getMemoryUsage() const;
+
+	static unsigned int bitsForPaletteSize(size_t paletteSize);
+
+private:
+	static constexpr unsigned int DIRECT_BITS = 16;
+
+	inline uint32_t readEntry(size_t index) const {
+		size_t bitIndex = index << _bitsShift;
+		return static_cast<uint32_t>(_data[bitIndex >> 6] >> (bitIndex & 63)) & _mask;
+	}
+
+	inline void writeEntry(size_t index, uint32_t value) {
+		size_t bitIndex = index << _bitsShift;
+		uint64_t &word = _data[bitIndex >> 6];
+		unsigned int shift = bitIndex & 63;
+		word = (word & ~(static_cast<uint64_t>(_mask) << shift)) | (static_cast<uint64_t>(value) << shift);
+	}
+
+	/// @brief Réencoder les données avec un nouveau nombre de bits par entrée
+	void resize(unsigned int bits);
+
+	size_t _size;
+	unsigned int _bits;
+	unsigned int _bitsShift; // log2(_bits)
+	uint32_t _mask;
+	std::vector<BlockID> _palette;
+	std::vector<uint64_t> _data;
+};
+
+} // namespace Voxel
+
+#endif // VOXEL_PALETTED_CONTAINER_HPP
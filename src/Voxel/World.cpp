@@ -0,0 +1,175 @@
+#include "World.hpp"
+
+namespace Voxel {
+
+World::World(BlockRegistryPtr registry) : _registry(registry), _meshingMode(MeshingMode::Greedy) {
+}
+
+const BlockRegistry &World::getRegistry() const {
+	return *_registry;
+}
+
+BlockRegistryPtr World::getRegistryPtr() const {
+	return _registry;
+}
+
+BlockID World::getBlock(int x, int y, int z) const {
+	const Chunk *chunk = getChunk(toChunkPos(x, y, z));
+	if (!chunk) {
+		return BLOCK_AIR;
+	}
+	return chunk->getBlock(toLocal(x), toLocal(y), toLocal(z));
+}
+
+void World::setBlock(int x, int y, int z, BlockID id) {
+	ChunkPos pos = toChunkPos(x, y, z);
+	Chunk *chunk = getChunk(pos);
+	if (!chunk) {
+		if (id == BLOCK_AIR) {
+			return; // inutile de créer un chunk vide
+		}
+		chunk = &getOrCreateChunk(pos);
+	}
+	int lx = toLocal(x), ly = toLocal(y), lz = toLocal(z);
+	if (chunk->getBlock(lx, ly, lz) == id) {
+		return;
+	}
+	bool wasDirty = chunk->isDirty();
+	chunk->setBlock(lx, ly, lz, id);
+	addChangedChunk(pos, wasDirty);
+
+	// Un bloc en bordure modifie la visibilité des faces du chunk voisin
+	if (lx == 0)			setNeighbourDirty(pos, -1, 0, 0);
+	if (lx == CHUNK_MASK)	setNeighbourDirty(pos,  1, 0, 0);
+	if (ly == 0)			setNeighbourDirty(pos, 0, -1, 0);
+	if (ly == CHUNK_MASK)	setNeighbourDirty(pos, 0,  1, 0);
+	if (lz == 0)			setNeighbourDirty(pos, 0, 0, -1);
+	if (lz == CHUNK_MASK)	setNeighbourDirty(pos, 0, 0,  1);
+}
+
+void World::setNeighbourDirty(const ChunkPos &pos, int dx, int dy, int dz) {
+	ChunkPos neighbourPos = {pos.x + dx, pos.y + dy, pos.z + dz};
+	Chunk *neighbour = getChunk(neighbourPos);
+	if (neighbour) {
+		addChangedChunk(neighbourPos, neighbour->isDirty());
+		neighbour->setDirty(true);
+	}
+}
+
+void World::setNeighboursDirty(const ChunkPos &pos) {
+	for (int d = -1; d <= 1; d += 2) {
+		setNeighbourDirty(pos, d, 0, 0);
+		setNeighbourDirty(pos, 0, d, 0);
+		setNeighbourDirty(pos, 0, 0, d);
+	}
+}
+
+void World::addChangedChunk(const ChunkPos &pos, bool wasDirty) {
+	if (!wasDirty) {
+		_changedChunks.push_back(pos);
+	}
+}
+
+Chunk *World::getChunk(const ChunkPos &pos) {
+	auto it = _chunks.find(pos);
+	return (it != _chunks.end()) ? it->second.get() : nullptr;
+}
+
+const Chunk *World::getChunk(const ChunkPos &pos) const {
+	auto it = _chunks.find(pos);
+	return (it != _chunks.end()) ? it->second.get() : nullptr;
+}
+
+Chunk &World::getOrCreateChunk(const ChunkPos &pos) {
+	auto &chunk = _chunks[pos];
+	if (!chunk) {
+		chunk = std::make_unique<Chunk>(pos);
+		chunk->setMeshingMode(_meshingMode);
+		addChangedChunk(pos, false);
+		setNeighboursDirty(pos);
+	}
+	return *chunk;
+}
+
+void World::removeChunk(const ChunkPos &pos) {
+	if (_chunks.erase(pos) > 0) {
+		_removedChunks.push_back(pos);
+		setNeighboursDirty(pos);
+	}
+}
+
+void World::clear() {
+	for (const auto &[pos, chunk] : _chunks) {
+		_removedChunks.push_back(pos);
+	}
+	_chunks.clear();
+}
+
+void World::setChunkDirty(const ChunkPos &pos) {
+	Chunk *chunk = getChunk(pos);
+	if (chunk) {
+		// Chunk::setBlock l'a peut-être déjà marqué sale sans qu'on le sache : toujours le noter
+		_changedChunks.push_back(pos);
+		chunk->setDirty(true);
+	}
+}
+
+const std::vector<ChunkPos> &World::getChangedChunks() const {
+	return _changedChunks;
+}
+
+const std::vector<ChunkPos> &World::getRemovedChunks() const {
+	return _removedChunks;
+}
+
+void World::clearChunkChanges() {
+	_changedChunks.clear();
+	_removedChunks.clear();
+}
+
+void World::setMeshingMode(MeshingMode mode) {
+	_meshingMode = mode;
+	for (auto &[pos, chunk] : _chunks) {
+		bool wasDirty = chunk->isDirty();
+		chunk->setMeshingMode(mode);
+		if (chunk->isDirty()) {
+			addChangedChunk(pos, wasDirty);
+		}
+	}
+}
+
+MeshingMode World::getMeshingMode() const {
+	return _meshingMode;
+}
+
+void World::compact() {
+	for (auto it = _chunks.begin(); it != _chunks.end();) {
+		if (it->second->isEmpty()) {
+			ChunkPos pos = it->first;
+			it = _chunks.erase(it);
+			_removedChunks.push_back(pos);
+			setNeighboursDirty(pos);
+		} else {
+			it->second->compact();
+			++it;
+		}
+	}
+}
+
+size_t World::getMemoryUsage() const {
+	size_t total = 0;
+	for (const auto &[pos, chunk] : _chunks) {
+		total += chunk->getMemoryUsage();
+	}
+	return total;
+}
+
+const World::ChunkMap &World::getChunks() const {
+	return _chunks;
+}
+
+size_t World::getChunkCount() const {
+	return _chunks.size();
+}
+
+} // namespace Voxel
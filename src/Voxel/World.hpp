@@ -0,0 +1,90 @@
+/**
+ * @file World.hpp
+ * @brief Monde voxel découpé en chunks
+ */
+
+#ifndef VOXEL_WORLD_HPP
+#define VOXEL_WORLD_HPP
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "Block.hpp"
+#include "Chunk.hpp"
+
+namespace Voxel {
+
+class World {
+public:
+	using ChunkMap = std::unordered_map<ChunkPos, std::unique_ptr<Chunk>, ChunkPosHash>;
+
+	World(BlockRegistryPtr registry);
+
+	const BlockRegistry &getRegistry() const;
+	BlockRegistryPtr getRegistryPtr() const;
+
+	/// @brief Lire un bloc en coordonnées monde (air si le chunk n'existe pas)
+	BlockID getBlock(int x, int y, int z) const;
+
+	/// @brief Modifier un bloc en coordonnées monde (le chunk est créé si besoin)
+	void setBlock(int x, int y, int z, BlockID id);
+
+	Chunk *getChunk(const ChunkPos &pos);
+	const Chunk *getChunk(const ChunkPos &pos) const;
+	Chunk &getOrCreateChunk(const ChunkPos &pos);
+	void removeChunk(const ChunkPos &pos);
+	void clear();
+
+	/// @brief Signaler un chunk modifié directement (Chunk::setBlock, Chunk::fill) pour qu'il soit remaillé
+	void setChunkDirty(const ChunkPos &pos);
+
+	/// @brief Chunks créés ou modifiés depuis le dernier clearChunkChanges() (une position peut revenir
+	/// plusieurs fois, ou désigner un chunk supprimé depuis : vérifier Chunk::isDirty)
+	const std::vector<ChunkPos> &getChangedChunks() const;
+	/// @brief Chunks supprimés depuis le dernier clearChunkChanges() (une position peut avoir été recréée depuis)
+	const std::vector<ChunkPos> &getRemovedChunks() const;
+	/// @brief Vider les deux listes, une fois traitées par le rendu
+	void clearChunkChanges();
+
+	/// @brief Mode de meshing des chunks existants et des chunks créés ensuite
+	void setMeshingMode(MeshingMode mode);
+	MeshingMode getMeshingMode() const;
+
+	/// @brief Compacter les palettes et supprimer les chunks vides (après un chargement ou de grosses modifications)
+	void compact();
+
+	/// @brief Mémoire occupée par les blocs de tous les chunks (en octets)
+	size_t getMemoryUsage() const;
+
+	const ChunkMap &getChunks() const;
+	size_t getChunkCount() const;
+
+	/// @brief Chunk contenant le bloc (division entière arrondie vers -inf)
+	static inline ChunkPos toChunkPos(int x, int y, int z) {
+		return {x >> CHUNK_SHIFT, y >> CHUNK_SHIFT, z >> CHUNK_SHIFT};
+	}
+
+	/// @brief Coordonnée locale du bloc dans son chunk
+	static inline int toLocal(int v) {
+		return v & CHUNK_MASK;
+	}
+
+private:
+	/// @brief Marquer un chunk voisin à reconstruire (ses faces de bordure dépendent de nous)
+	void setNeighbourDirty(const ChunkPos &pos, int dx, int dy, int dz);
+	void setNeighboursDirty(const ChunkPos &pos);
+	/// @brief Noter le chunk dans _changedChunks s'il n'y était pas déjà (un chunk sale y est déjà)
+	void addChangedChunk(const ChunkPos &pos, bool wasDirty);
+
+	BlockRegistryPtr _registry;
+	ChunkMap _chunks;
+	MeshingMode _meshingMode;
+	std::vector<ChunkPos> _changedChunks;	// à remailler, sans parcourir tous les chunks
+	std::vector<ChunkPos> _removedChunks;
+};
+
+using WorldPtr = std::shared_ptr<World>;
+
+} // namespace Voxel
+
+#endif // VOXEL_WORLD_HPP
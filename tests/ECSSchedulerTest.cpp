@@ -0,0 +1,326 @@
+// ECS scheduler test: runs the same systems on two identical worlds, serially and with the
+// parallel scheduler, and compares every component bit for bit
+// Usage: ECSSchedulerTest [entity count] (100k by default), exits with 1 if the worlds differ
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "Core/Logger.hpp"
+#include "ECS/Components.hpp"
+#include "ECS/Manager.hpp"
+
+namespace {
+
+// Systems of the scheduler check: floating point updates whose result depends on the order
+// of the systems that write the same components (gravity -> move -> damping), plus systems
+// that only conflict with some of them (colors, bounds, expiry). Colors and expiry also
+// create and destroy entities through their command buffers.
+
+class GravitySystem : public SystemBase {
+public:
+    GravitySystem(std::shared_ptr<Manager> manager, int p) : SystemBase(manager, p), view(manager->query<MobileComponent>()) {
+        writes<MobileComponent>();
+    }
+
+    void preUpdate(SDL_Event*, SDL_Renderer*, float) override {}
+    void update(SDL_Event*, SDL_Renderer*, float deltaTime) override {
+        view.forEach([deltaTime](EntityID, MobileComponent& mobile) {
+            mobile.velocity.y -= 9.81f * deltaTime;
+        });
+    }
+    void postUpdate(SDL_Event*, SDL_Renderer*, float) override {}
+
+private:
+    View<MobileComponent> view;
+};
+
+class MoveSystem : public SystemBase {
+public:
+    MoveSystem(std::shared_ptr<Manager> manager, int p)
+        : SystemBase(manager, p), view(manager->query<TransformComponent, const MobileComponent>()) {
+        reads<MobileComponent>();
+        writes<TransformComponent>();
+    }
+
+    void preUpdate(SDL_Event*, SDL_Renderer*, float) override {}
+    void update(SDL_Event*, SDL_Renderer*, float deltaTime) override {
+        view.forEach([deltaTime](EntityID, TransformComponent& transform, const MobileComponent& mobile) {
+            transform.position += mobile.velocity * deltaTime;
+            if (transform.position.y < 0.0f) {
+                transform.position.y = -transform.position.y;
+            }
+        });
+    }
+    void postUpdate(SDL_Event*, SDL_Renderer*, float) override {}
+
+private:
+    View<TransformComponent, const MobileComponent> view;
+};
+
+class DampingSystem : public SystemBase {
+public:
+    DampingSystem(std::shared_ptr<Manager> manager, int p)
+        : SystemBase(manager, p), view(manager->query<const TransformComponent, MobileComponent>()) {
+        reads<TransformComponent>();
+        writes<MobileComponent>();
+    }
+
+    void preUpdate(SDL_Event*, SDL_Renderer*, float) override {}
+    void update(SDL_Event*, SDL_Renderer*, float) override {
+        view.forEach([](EntityID, const TransformComponent& transform, MobileComponent& mobile) {
+            // Bounce on the ground
+            if (transform.position.y < 0.1f && mobile.velocity.y < 0.0f) {
+                mobile.velocity.y = -mobile.velocity.y;
+            }
+            mobile.velocity *= 0.999f;
+        });
+    }
+    void postUpdate(SDL_Event*, SDL_Renderer*, float) override {}
+
+private:
+    View<const TransformComponent, MobileComponent> view;
+};
+
+class ColorCycleSystem : public SystemBase {
+public:
+    ColorCycleSystem(std::shared_ptr<Manager> manager, int p) : SystemBase(manager, p), view(manager->query<ColorComponent>()) {
+        writes<ColorComponent>();
+    }
+
+    void preUpdate(SDL_Event*, SDL_Renderer*, float) override {}
+    void update(SDL_Event*, SDL_Renderer*, float) override {
+        view.forEach([](EntityID, ColorComponent& color) {
+            uint32_t rgba = color.getColor();
+            color.setColor((rgba << 8) | (rgba >> 24));
+        });
+        // Color-only entities, spawned while the other systems run
+        if (++frame % 10 == 0) {
+            EntityID entity = commands.createEntity();
+            commands.add<ColorComponent>(entity, static_cast<uint32_t>(frame));
+        }
+    }
+    void postUpdate(SDL_Event*, SDL_Renderer*, float) override {}
+
+private:
+    View<ColorComponent> view;
+    uint32_t frame = 0;
+};
+
+// Entities that leave the area are destroyed and replaced by a new one at the center
+class ExpirySystem : public SystemBase {
+public:
+    ExpirySystem(std::shared_ptr<Manager> manager, int p)
+        : SystemBase(manager, p), view(manager->query<const TransformComponent, const MobileComponent>()) {
+        reads<TransformComponent, MobileComponent>();
+    }
+
+    void preUpdate(SDL_Event*, SDL_Renderer*, float) override {}
+    void update(SDL_Event*, SDL_Renderer*, float) override {
+        view.forEach([this](EntityID entity, const TransformComponent& transform, const MobileComponent& mobile) {
+            if (std::abs(transform.position.x) < 100.0f && std::abs(transform.position.z) < 100.0f) {
+                return;
+            }
+            commands.destroyEntity(entity);
+            EntityID replacement = commands.createEntity();
+            commands.add<TransformComponent>(replacement, glm::vec3(0.0f, 50.0f, 0.0f));
+            commands.add<MobileComponent>(replacement, MobileComponent::DYNAMIC, glm::vec3(-mobile.velocity.z, 0.0f, mobile.velocity.x));
+        });
+    }
+    void postUpdate(SDL_Event*, SDL_Renderer*, float) override {}
+
+private:
+    View<const TransformComponent, const MobileComponent> view;
+};
+
+// Reads the positions after the move: sum of the heights per frame
+class BoundsSystem : public SystemBase {
+public:
+    std::vector<double> heights;
+
+    BoundsSystem(std::shared_ptr<Manager> manager, int p) : SystemBase(manager, p), view(manager->query<const TransformComponent>()) {
+        reads<TransformComponent>();
+    }
+
+    void preUpdate(SDL_Event*, SDL_Renderer*, float) override {}
+    void update(SDL_Event*, SDL_Renderer*, float) override {}
+    void postUpdate(SDL_Event*, SDL_Renderer*, float) override {
+        double sum = 0.0;
+        view.forEach([&sum](EntityID, const TransformComponent& transform) {
+            sum += transform.position.y;
+        });
+        heights.push_back(sum);
+    }
+
+private:
+    View<const TransformComponent> view;
+};
+
+// Counts the entities spawned since its previous call (initial ones, expiry replacements, colors)
+// and the colors written since then: change ticks must not depend on the order of the threads
+class SpawnCounterSystem : public SystemBase {
+public:
+    std::vector<size_t> counts;
+
+    SpawnCounterSystem(std::shared_ptr<Manager> manager, int p)
+        : SystemBase(manager, p), spawned(manager->query<Added<const TransformComponent>>()),
+          recolored(manager->query<Changed<const ColorComponent>>()) {
+        reads<TransformComponent, ColorComponent>();
+    }
+
+    void preUpdate(SDL_Event*, SDL_Renderer*, float) override {}
+    void update(SDL_Event*, SDL_Renderer*, float) override {
+        size_t count = 0;
+        spawned.forEach([&count](EntityID, const TransformComponent&) { count++; });
+        counts.push_back(count);
+        count = 0;
+        recolored.forEach([&count](EntityID, const ColorComponent&) { count++; });
+        counts.push_back(count);
+    }
+    void postUpdate(SDL_Event*, SDL_Renderer*, float) override {}
+
+private:
+    View<Added<const TransformComponent>> spawned;
+    View<Changed<const ColorComponent>> recolored;
+};
+
+// Every system holds a shared_ptr to the Manager that owns it: the systems are deleted
+// with the world, otherwise neither would ever be freed
+struct SchedulerWorld {
+    std::shared_ptr<Manager> manager = std::make_shared<Manager>();
+    std::vector<SystemBase*> systems;
+    BoundsSystem* bounds = nullptr;
+    SpawnCounterSystem* spawns = nullptr;
+
+    SchedulerWorld() = default;
+    SchedulerWorld(const SchedulerWorld&) = delete;
+    SchedulerWorld& operator=(const SchedulerWorld&) = delete;
+
+    ~SchedulerWorld() {
+        for (SystemBase* system : systems) {
+            manager->deleteSystem(system);
+        }
+    }
+
+    template<typename S>
+    S* addSystem(int priority) {
+        auto system = std::make_unique<S>(manager, priority);
+        S* pointer = system.get();
+        systems.push_back(pointer);
+        manager->addSystem(std::move(system));
+        return pointer;
+    }
+};
+
+void buildSchedulerWorld(SchedulerWorld& world, size_t entityCount) {
+    std::mt19937 random(4321);
+    std::uniform_real_distribution<float> coordinate(-100.0f, 100.0f);
+    for (size_t i = 0; i < entityCount; ++i) {
+        EntityID entity = world.manager->createEntity();
+        world.manager->add<TransformComponent>(entity, glm::vec3(coordinate(random), 50.0f + coordinate(random) * 0.5f, coordinate(random)));
+        world.manager->add<MobileComponent>(entity, MobileComponent::DYNAMIC, glm::vec3(coordinate(random), 0.0f, coordinate(random)) * 0.1f);
+        if (i % 3 == 0) {
+            world.manager->add<ColorComponent>(entity, static_cast<uint32_t>(random()));
+        }
+    }
+
+    world.addSystem<GravitySystem>(0);
+    world.addSystem<ColorCycleSystem>(1);
+    world.addSystem<MoveSystem>(2);
+    world.addSystem<DampingSystem>(3);
+    world.bounds = world.addSystem<BoundsSystem>(4);
+    world.addSystem<ExpirySystem>(5);
+    world.spawns = world.addSystem<SpawnCounterSystem>(6);
+}
+
+template<typename T>
+bool sameBytes(const T& a, const T& b) {
+    return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+// Entities and components in iteration order: identical worlds give identical lists
+struct WorldState {
+    std::vector<EntityID> entities;
+    std::vector<glm::vec3> positions, velocities;
+    std::vector<uint32_t> colors;
+};
+
+WorldState captureWorld(Manager& manager) {
+    WorldState state;
+    manager.forEach<const TransformComponent, const MobileComponent>([&state](EntityID entity, const TransformComponent& transform, const MobileComponent& mobile) {
+        state.entities.push_back(entity);
+        state.positions.push_back(transform.position);
+        state.velocities.push_back(mobile.velocity);
+    });
+    manager.forEach<ColorComponent>([&state](EntityID entity, ColorComponent& color) {  // getColor is not const
+        state.entities.push_back(entity);
+        state.colors.push_back(color.getColor());
+    });
+    return state;
+}
+
+bool checkSystemScheduler(size_t entityCount) {
+    using Clock = std::chrono::steady_clock;
+    const int frames = 200;
+    const float dt = 1.0f / 60.0f;
+
+    SchedulerWorld serial, parallel;
+    buildSchedulerWorld(serial, entityCount);
+    buildSchedulerWorld(parallel, entityCount);
+    parallel.manager->enableParallelSystems();
+
+    auto start = Clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        serial.manager->updateSystems(nullptr, nullptr, dt);
+    }
+    float serialMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count() / frames;
+
+    start = Clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        parallel.manager->updateSystems(nullptr, nullptr, dt);
+    }
+    float parallelMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count() / frames;
+
+    WorldState stateA = captureWorld(*serial.manager);
+    WorldState stateB = captureWorld(*parallel.manager);
+    size_t mismatches = 0;
+    if (stateA.entities.size() != stateB.entities.size() || stateA.colors.size() != stateB.colors.size()) {
+        mismatches = std::max(stateA.entities.size(), stateB.entities.size());
+    } else {
+        for (size_t i = 0; i < stateA.entities.size(); ++i) {
+            mismatches += stateA.entities[i] != stateB.entities[i];
+        }
+        for (size_t i = 0; i < stateA.positions.size(); ++i) {
+            mismatches += !sameBytes(stateA.positions[i], stateB.positions[i]) || !sameBytes(stateA.velocities[i], stateB.velocities[i]);
+        }
+        for (size_t i = 0; i < stateA.colors.size(); ++i) {
+            mismatches += stateA.colors[i] != stateB.colors[i];
+        }
+    }
+    bool sameHeights = serial.bounds->heights.size() == parallel.bounds->heights.size()
+        && std::memcmp(serial.bounds->heights.data(), parallel.bounds->heights.data(), serial.bounds->heights.size() * sizeof(double)) == 0;
+    bool sameSpawns = serial.spawns->counts == parallel.spawns->counts;
+
+    LOG(Info) << "ECS scheduler check: " << entityCount << " entities (" << serial.manager->getEntityCount()
+              << " after expiry and spawns), " << frames << " frames, "
+              << "serial " << serialMs << " ms / frame, parallel " << parallelMs << " ms / frame";
+    if (mismatches != 0 || !sameHeights || !sameSpawns) {
+        LOG(Error) << "Parallel systems differ from the serial path: " << mismatches << " entities, heights "
+                   << (sameHeights ? "identical" : "different") << ", change detection " << (sameSpawns ? "identical" : "different");
+        return false;
+    }
+    LOG(Info) << "Parallel systems identical to the serial path";
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    LOG_TERMINAL_ENABLE();
+    size_t entityCount = argc > 1 ? std::stoul(argv[1]) : 100000;
+    return checkSystemScheduler(entityCount) ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file OcclusionBufferTest.cpp
+ * @brief Visibilité de boîtes connues derrière des murs dessinés dans OcclusionBuffer (sans fenêtre ni OpenGL)
+ * Utilisation : OcclusionBufferTest, code de retour 1 si un cas échoue
+ */
+
+#include <glm/gtc/matrix_transform.hpp>
+#include "Core/Logger.hpp"
+#include "Render3D/OcclusionBuffer.hpp"
+
+using namespace Render3D;
+
+namespace {
+
+struct VisibilityCase {
+	const char *name;
+	AABB box;
+	bool visible;
+};
+
+} // namespace
+
+int main() {
+	LOG_TERMINAL_ENABLE();
+
+	// Caméra à l'origine regardant vers -z, 90° vertical et image 2:1 comme le tampon 256x128 :
+	// un point (x, y, z) tombe au pixel (128 + 64 * x / -z, 64 + 64 * y / -z)
+	OcclusionBuffer buffer;
+	buffer.clear(glm::perspective(glm::radians(90.0f), 2.0f, 0.1f, 100.0f) *
+				 glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+
+	// Mur face à la caméra à z = -10 : pixels 96 à 160 en x, 32 à 96.6 en y.
+	// Son bord haut passe au milieu de la ligne 96 (centre à 96.5 couvert, haut du pixel non couvert)
+	bool drawn = buffer.drawRectangle({glm::vec3(-5.0f, -5.0f, -10.0f), glm::vec3(5.0f, 5.09375f, -10.0f)});
+	// Second mur plus loin à gauche, à z = -30 : pixels 64 à 85.3 en x (isVisible peut tester
+	// les pixels 4 par 4, la boîte cachée derrière reste donc dans les groupes 64 à 83)
+	drawn &= buffer.drawRectangle({glm::vec3(-30.0f, -5.0f, -30.0f), glm::vec3(-20.0f, 5.0f, -30.0f)});
+	// Sol qui passe sous la caméra : coupé par le plan proche, il n'est pas dessiné
+	bool nearPlaneSkipped = !buffer.drawRectangle({glm::vec3(-5.0f, -2.0f, -5.0f), glm::vec3(5.0f, -2.0f, 5.0f)});
+
+	const VisibilityCase cases[] = {
+		{"fully behind the wall", {glm::vec3(-1.0f, -1.0f, -21.0f), glm::vec3(1.0f, 1.0f, -20.0f)}, false},
+		{"behind the far wall", {glm::vec3(-34.0f, -1.0f, -41.0f), glm::vec3(-30.0f, 1.0f, -40.0f)}, false},
+		{"beside the wall", {glm::vec3(12.0f, -1.0f, -21.0f), glm::vec3(14.0f, 1.0f, -20.0f)}, true},
+		// Dépasse le haut du mur de 0.2 pixel dans la ligne 96, que le mur ne couvre qu'en partie
+		{"straddling the wall silhouette", {glm::vec3(-1.0f, 0.0f, -21.0f), glm::vec3(1.0f, 10.25f, -20.0f)}, true},
+		{"between the two walls", {glm::vec3(-20.0f, -1.0f, -26.0f), glm::vec3(-18.0f, 1.0f, -25.0f)}, true},
+		{"in front of the wall", {glm::vec3(-1.0f, -1.0f, -6.0f), glm::vec3(1.0f, 1.0f, -5.0f)}, true},
+		{"crossing the near plane", {glm::vec3(-1.0f, -1.0f, -1.0f), glm::vec3(1.0f, 1.0f, 1.0f)}, true},
+	};
+
+	int failures = 0;
+	if (!drawn || buffer.getQuadCount() != 2) {
+		LOG(Error) << "Occluders not drawn: " << buffer.getQuadCount() << " quads";
+		failures++;
+	}
+	if (!nearPlaneSkipped) {
+		LOG(Error) << "Occluder crossing the near plane was drawn";
+		failures++;
+	}
+	for (const auto &test : cases) {
+		bool visible = buffer.isVisible(test.box);
+		if (visible != test.visible) {
+			LOG(Error) << "Box " << test.name << ": " << (visible ? "visible" : "hidden") << ", expected "
+					   << (test.visible ? "visible" : "hidden");
+			failures++;
+		}
+	}
+	if (failures != 0) {
+		return 1;
+	}
+	LOG(Info) << "Occlusion buffer: " << sizeof(cases) / sizeof(cases[0]) << " boxes with the expected visibility";
+	return 0;
+}